@@ -0,0 +1,154 @@
+// Проверка dnsResolver_t на локальном UDP ответчике: ответ, кэш, отрицательный ответ, таймаут,
+// очистка кэша из обработчика и обслуживание клиента циклом TCP_reactor_t.
+// Сборка (Linux): g++ -std=c++20 -I../win_server dns_test.cpp $(ls ../win_server/*.cpp | grep -v win_server.cpp) -o dns_test -pthread
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <thread>
+
+#include "dns.h"
+#include "reactor.h"
+
+namespace
+{
+    const unsigned short RESPONDER_PORT = 35353; // порт локального ответчика
+
+    int failures = 0; // количество проваленных проверок
+
+    void Check(bool condition, const char* what)
+    {
+        printf("%s: %s\n", condition ? "ok  " : "FAIL", what);
+        if (!condition)
+            ++failures;
+    }
+
+    /// <summary>
+    /// Ответчик: на имя "silent.test" молчит, на "missing.test" отвечает NXDOMAIN, на остальные - записью A 10.1.2.3
+    /// с TTL 60. Датаграмма "stop" завершает поток
+    /// </summary>
+    void Responder(network::UDP_socket_t& socket, std::atomic<unsigned short>& clientPort)
+    {
+        char buffer[512];
+        int size = 0;
+        while ((size = socket.RecvFrom(network::slice_t(buffer, sizeof(buffer)))) > 0)
+        {
+            std::string query(buffer, size);
+            if (query == "stop")
+                break;
+            if (query.size() < 12 || query.find("\x06silent\x04test") != std::string::npos)
+                continue;
+            clientPort = socket.GetLastCommunication().GetPort();
+
+            std::string answer(query);
+            answer[2] = char(0x81); // ответ, рекурсия запрошена
+            answer[3] = char(0x80); // рекурсия доступна
+            if (query.find("\x07missing\x04test") != std::string::npos)
+                answer[3] = char(0x83); // NXDOMAIN без SOA - срок из SetTTL
+            else
+            {
+                answer[7] = 1; // одна запись ответа
+                const char record[16] = { char(0xC0), 0x0C, 0x00, 0x01, 0x00, 0x01, 0x00, 0x00, 0x00, 0x3C, 0x00, 0x04, 10, 1, 2, 3 };
+                answer.append(record, sizeof(record));
+            }
+            socket.SendTo(answer, socket.GetLastCommunication());
+        }
+    }
+
+    /// <summary>
+    /// Обработчик результатов: запоминает последний результат, по флагу очищает кэш прямо из вызова
+    /// </summary>
+    class handler_t : public network::ABSdnsHandler
+    {
+    public:
+        handler_t(network::dnsResolver_t& resolver, log_t& logger) : resolver(resolver), addr(logger), calls(0), status(1), clearCache(false)
+        {}
+
+        void OnResolve(int /*reqID*/, int status, const network::sockInfo_t& addr) override
+        {
+            ++calls;
+            this->status = status;
+            this->addr.setSockInfo(addr);
+            if (clearCache)
+                resolver.ClearCache();
+        }
+
+        network::dnsResolver_t& resolver;
+        network::sockInfo_t addr;
+        int calls;
+        int status;
+        bool clearCache;
+    };
+
+    /// <summary>
+    /// Метод прокрутки цикла, пока обработчик не получит нужное количество результатов
+    /// </summary>
+    void Spin(network::TCP_reactor_t& reactor, handler_t& handler, int calls)
+    {
+        for (int iteration = 0; iteration < 200 && handler.calls < calls; ++iteration)
+            reactor.Work(10);
+    }
+
+    class nullReactorHandler_t : public network::ABSreactorHandler
+    {
+    public:
+        void OnMessage(int /*connID*/, std::string& /*msg*/) override {}
+    };
+}
+
+int main()
+{
+    log_t logger;
+    network::UDP_socket_t responderSocket("127.0.0.1", RESPONDER_PORT, logger);
+    std::atomic<unsigned short> clientPort(0);
+    std::thread responder([&]() { Responder(responderSocket, clientPort); });
+
+    {
+        network::dnsResolver_t resolver("127.0.0.1", RESPONDER_PORT, logger);
+        resolver.SetTimeout(50, 2);
+        resolver.SetTTL(30, 3600);
+        nullReactorHandler_t reactorHandler;
+        network::TCP_reactor_t reactor(nullptr, reactorHandler, logger);
+        reactor.SetResolver(&resolver);
+        handler_t handler(resolver, logger);
+        network::sockInfo_t addr(logger);
+
+        // ответ приходит обработчику из итерации цикла
+        int reqID = resolver.Resolve("Host.Test.", 8080, addr, handler);
+        Check(reqID > 0, "query sent to the server");
+        Spin(reactor, handler, 1);
+        Check(handler.calls == 1 && handler.status == 0, "answer delivered by the reactor");
+        Check(handler.addr.GetIP() == "10.1.2.3" && handler.addr.GetPort() == 8080, "address and port of the answer");
+        Check(clientPort != 0 && clientPort == resolver.GetSocket()->GetPort(), "query sent from the bound random port");
+
+        // повтор берется из кэша без сервера
+        Check(resolver.Resolve("host.test", 80, addr, handler) == 0 && addr.GetIP() == "10.1.2.3", "answer from cache");
+
+        // два ожидающих одного имени, первый очищает кэш из обработчика
+        handler.clearCache = true;
+        Check(resolver.Resolve("other.test", 80, addr, handler) > 0 && resolver.Resolve("other.test", 81, addr, handler) > 0,
+            "two waiters share one query");
+        Spin(reactor, handler, 3);
+        Check(handler.calls == 3 && handler.status == 0 && handler.addr.GetPort() == 81, "cache cleared from handler");
+        handler.clearCache = false;
+
+        // отрицательный ответ кэшируется
+        Check(resolver.Resolve("missing.test", 80, addr, handler) > 0, "negative query sent");
+        Spin(reactor, handler, 4);
+        Check(handler.calls == 4 && handler.status == -1, "NXDOMAIN delivered");
+        Check(resolver.Resolve("missing.test", 80, addr, handler) == -1, "NXDOMAIN from cache");
+
+        // сервер молчит - после всех попыток отказ
+        Check(resolver.Resolve("silent.test", 80, addr, handler) > 0, "unanswered query sent");
+        Spin(reactor, handler, 5);
+        Check(handler.calls == 5 && handler.status == -2 && resolver.GetPendingCount() == 0, "timeout after all attempts");
+
+        reactor.SetResolver(nullptr);
+    }
+
+    network::UDP_socket_t stopSocket(AF_INET, logger);
+    stopSocket.SendTo("stop", "127.0.0.1", RESPONDER_PORT);
+    responder.join();
+
+    printf("%s\n", failures == 0 ? "all passed" : "FAILED");
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,176 @@
+// Нагрузочная проверка mpmcQueue_t и wsDeque_t: каждый поставленный элемент изымается ровно один раз -
+// при многих писателях и читателях с многократным переходом кольца через край и при одновременном перехвате.
+// Сборка (Linux): g++ -std=c++20 -O2 -I../win_server queue_test.cpp -o queue_test -pthread
+// (для проверки гонок добавить -fsanitize=thread)
+#include <atomic>
+#include <cstdio>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "mpmcQueue.h"
+#include "wsDeque.h"
+
+namespace
+{
+    const size_t WRITERS = 4; // потоков-писателей очереди
+    const size_t READERS = 4; // потоков-читателей очереди
+    const size_t PER_WRITER = 200000; // элементов на писателя
+    const size_t THIEVES = 3; // потоков-перехватчиков дека
+    const size_t DEQUE_ITEMS = 400000; // элементов через дек
+    const size_t CAPACITY = 64; // малая емкость - кольцо проходит через край тысячи раз
+
+    int failures = 0; // количество проваленных проверок
+
+    void Check(bool condition, const char* what)
+    {
+        printf("%s: %s\n", condition ? "ok  " : "FAIL", what);
+        if (!condition)
+            ++failures;
+    }
+
+    /// <summary>
+    /// Метод проверки счетчиков изъятий: каждый элемент изъят ровно один раз
+    /// </summary>
+    bool ExactlyOnce(const std::unique_ptr<std::atomic<unsigned>[]>& p_taken, size_t count)
+    {
+        for (size_t index = 0; index < count; ++index)
+            if (p_taken[index].load() != 1)
+                return false;
+        return true;
+    }
+
+    /// <summary>
+    /// Многие писатели и читатели через кольцо mpmcQueue_t. Элемент - номер писателя * PER_WRITER + порядковый номер,
+    /// читатель дополнительно проверяет, что элементы одного писателя приходят к нему по возрастанию
+    /// </summary>
+    void QueueTest()
+    {
+        const size_t TOTAL = WRITERS * PER_WRITER;
+        mpmcQueue_t<size_t> queue(CAPACITY);
+        std::unique_ptr<std::atomic<unsigned>[]> p_taken(new std::atomic<unsigned>[TOTAL]);
+        for (size_t index = 0; index < TOTAL; ++index)
+            p_taken[index].store(0);
+        std::atomic<size_t> popped(0);
+        std::atomic<size_t> pushFull(0); // сколько раз писатель упирался в заполненное кольцо
+        std::atomic_bool ordered(true);
+
+        std::vector<std::thread> v_thread;
+        for (size_t writer = 0; writer < WRITERS; ++writer)
+            v_thread.push_back(std::thread([&, writer]()
+            {
+                for (size_t index = 0; index < PER_WRITER; ++index)
+                {
+                    size_t value = writer * PER_WRITER + index;
+                    while (!queue.TryPush(value))
+                    {
+                        pushFull.fetch_add(1, std::memory_order_relaxed);
+                        std::this_thread::yield();
+                    }
+                }
+            }));
+        for (size_t reader = 0; reader < READERS; ++reader)
+            v_thread.push_back(std::thread([&]()
+            {
+                std::vector<size_t> v_last(WRITERS, 0); // следующий ожидаемый минимум по каждому писателю
+                size_t value = 0;
+                while (popped.load() < TOTAL)
+                    if (queue.TryPop(value))
+                    {
+                        p_taken[value].fetch_add(1);
+                        popped.fetch_add(1);
+                        size_t writer = value / PER_WRITER;
+                        if (value % PER_WRITER < v_last[writer])
+                            ordered = false;
+                        v_last[writer] = value % PER_WRITER + 1;
+                    }
+                    else
+                        std::this_thread::yield();
+            }));
+        for (size_t index = 0; index < v_thread.size(); ++index)
+            v_thread[index].join();
+
+        Check(popped.load() == TOTAL && queue.Empty(), "mpmcQueue_t: all items popped, queue empty");
+        Check(ExactlyOnce(p_taken, TOTAL), "mpmcQueue_t: every item popped exactly once across wraparound");
+        Check(ordered.load(), "mpmcQueue_t: items of one writer keep their order");
+        Check(pushFull.load() != 0, "mpmcQueue_t: writers hit the full ring (wraparound exercised)");
+    }
+
+    /// <summary>
+    /// Владелец кладет элементы в wsDeque_t и сам забирает часть снизу, перехватчики одновременно забирают сверху.
+    /// Последний элемент дека разыгрывается между владельцем и перехватчиками
+    /// </summary>
+    void DequeTest()
+    {
+        wsDeque_t<size_t> deque(CAPACITY);
+        std::unique_ptr<size_t[]> p_items(new size_t[DEQUE_ITEMS]); // дек хранит указатели - на эти элементы
+        std::unique_ptr<std::atomic<unsigned>[]> p_taken(new std::atomic<unsigned>[DEQUE_ITEMS]);
+        for (size_t index = 0; index < DEQUE_ITEMS; ++index)
+        {
+            p_items[index] = index;
+            p_taken[index].store(0);
+        }
+        std::atomic<size_t> stolen(0);
+        std::atomic<size_t> taken(0);
+        std::atomic_bool done(false);
+
+        std::vector<std::thread> v_thief;
+        for (size_t thief = 0; thief < THIEVES; ++thief)
+            v_thief.push_back(std::thread([&]()
+            {
+                for (;;)
+                {
+                    bool finished = done.load(); // читаем до попытки: после done дек только пустеет
+                    if (size_t* p_item = deque.Steal())
+                    {
+                        p_taken[*p_item].fetch_add(1);
+                        stolen.fetch_add(1);
+                        taken.fetch_add(1);
+                    }
+                    else if (finished && deque.Empty())
+                        break;
+                }
+            }));
+
+        size_t ownPops = 0;
+        for (size_t index = 0; index < DEQUE_ITEMS; ++index)
+        {
+            while (!deque.Push(&p_items[index]))
+                if (size_t* p_item = deque.Pop()) // дек заполнен - разгружаем снизу
+                {
+                    p_taken[*p_item].fetch_add(1);
+                    ++ownPops;
+                    taken.fetch_add(1);
+                }
+            if (index % 3 == 0)
+                if (size_t* p_item = deque.Pop()) // часто забираем последний элемент - гонка с перехватчиками за верх
+                {
+                    p_taken[*p_item].fetch_add(1);
+                    ++ownPops;
+                    taken.fetch_add(1);
+                }
+        }
+        while (size_t* p_item = deque.Pop())
+        {
+            p_taken[*p_item].fetch_add(1);
+            ++ownPops;
+            taken.fetch_add(1);
+        }
+        done = true;
+        for (size_t index = 0; index < v_thief.size(); ++index)
+            v_thief[index].join();
+
+        Check(taken.load() == DEQUE_ITEMS && deque.Empty(), "wsDeque_t: all items taken, deque empty");
+        Check(ExactlyOnce(p_taken, DEQUE_ITEMS), "wsDeque_t: every item taken exactly once with concurrent steals");
+        Check(ownPops != 0 && stolen.load() != 0, "wsDeque_t: both the owner and the thieves took items");
+    }
+}
+
+int main()
+{
+    QueueTest();
+    DequeTest();
+
+    printf("%s\n", failures == 0 ? "all passed" : "FAILED");
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,99 @@
+#include "buffer.h"
+
+#include <cstring>
+
+/// <summary>
+/// 
+/// </summary>
+/// <param name="capacity"> -   </param>
+network::buffer_t::buffer_t(size_t capacity) : p_data(new char[capacity ? capacity : 1]), capacity(capacity ? capacity : 1), readPos(0), writePos(0)
+{}
+
+/// <summary>
+///       .    minSize,  
+///   ,        -  
+/// </summary>
+/// <param name="minSize"> -      </param>
+/// <returns>    </returns>
+network::slice_t network::buffer_t::WriteSlice(size_t minSize)
+{
+    if (capacity - writePos < minSize)
+    {
+        size_t size = writePos - readPos;
+        if (capacity - size >= minSize)
+        { //  ,     
+            memmove(&p_data[0], &p_data[readPos], size);
+        }
+        else
+        { //    - 
+            size_t newCapacity = capacity * 2;
+            while (newCapacity - size < minSize)
+                newCapacity *= 2;
+            std::unique_ptr<char[]> p_newData(new char[newCapacity]);
+            memcpy(&p_newData[0], &p_data[readPos], size);
+            p_data.swap(p_newData);
+            capacity = newCapacity;
+        }
+        readPos = 0;
+        writePos = size;
+    }
+
+    return slice_t(&p_data[writePos], capacity - writePos);
+}
+
+/// <summary>
+///       
+/// </summary>
+/// <param name="size"> -    </param>
+void network::buffer_t::Commit(size_t size)
+{
+    writePos += size;
+    if (writePos > capacity)
+        writePos = capacity;
+}
+
+/// <summary>
+///    
+/// </summary>
+/// <returns>    </returns>
+network::slice_t network::buffer_t::ReadSlice() const
+{
+    return slice_t(&p_data[readPos], writePos - readPos);
+}
+
+/// <summary>
+///       
+/// </summary>
+/// <param name="size"> -    </param>
+void network::buffer_t::Consume(size_t size)
+{
+    readPos += size;
+    if (readPos >= writePos) //   -   ,   
+        readPos = writePos = 0;
+}
+
+/// <summary>
+///    ( )
+/// </summary>
+void network::buffer_t::Clear()
+{
+    readPos = writePos = 0;
+}
+
+/// <summary>
+///     
+/// </summary>
+/// <returns>    </returns>
+size_t network::buffer_t::Size() const
+{
+    return writePos - readPos;
+}
+
+/// <summary>
+///    
+/// </summary>
+/// <returns>    </returns>
+size_t network::buffer_t::Capacity() const
+{
+    return capacity;
+}
@@ -0,0 +1,91 @@
+#pragma once
+#ifndef BUFFER_H_
+#define BUFFER_H_
+
+#include <cstddef>
+#include <memory>
+
+namespace network
+{
+    /// <summary>
+    ///   :   . ,      -
+    /// </summary>
+    struct slice_t
+    {
+        slice_t() : data(nullptr), size(0)
+        {}
+        slice_t(char* data, size_t size) : data(data), size(size)
+        {}
+        char* data; //  
+        size_t size; //  
+    };
+
+    /// <summary>
+    ///   :      ,     .
+    ///      ,          
+    /// </summary>
+    class buffer_t
+    {
+    public:
+        /// <summary>
+        /// 
+        /// </summary>
+        /// <param name="capacity"> -   </param>
+        explicit buffer_t(size_t capacity = 2048);
+
+        //  -    ,    
+        buffer_t(const buffer_t& buffer) = delete;
+        buffer_t& operator = (const buffer_t& buffer) = delete;
+
+        /// <summary>
+        ///       .    minSize,  
+        ///   ,        -  
+        /// </summary>
+        /// <param name="minSize"> -      </param>
+        /// <returns>    </returns>
+        slice_t WriteSlice(size_t minSize);
+
+        /// <summary>
+        ///       
+        /// </summary>
+        /// <param name="size"> -    </param>
+        void Commit(size_t size);
+
+        /// <summary>
+        ///    
+        /// </summary>
+        /// <returns>    </returns>
+        slice_t ReadSlice() const;
+
+        /// <summary>
+        ///       
+        /// </summary>
+        /// <param name="size"> -    </param>
+        void Consume(size_t size);
+
+        /// <summary>
+        ///    ( )
+        /// </summary>
+        void Clear();
+
+        /// <summary>
+        ///     
+        /// </summary>
+        /// <returns>    </returns>
+        size_t Size() const;
+
+        /// <summary>
+        ///    
+        /// </summary>
+        /// <returns>    </returns>
+        size_t Capacity() const;
+
+    protected:
+        std::unique_ptr<char[]> p_data; //  
+        size_t capacity; // 
+        size_t readPos; //   
+        size_t writePos; //   
+    };
+};
+
+#endif /* BUFFER_H_ */
@@ -0,0 +1,272 @@
+#include "codec.h"
+
+#include <cstring>
+
+/// <summary>
+/// 
+/// </summary>
+/// <param name="delimiter"> -   ,   </param>
+/// <param name="maxSize"> -      </param>
+network::delimiterCodec_t::delimiterCodec_t(const std::string& delimiter, size_t maxSize) : delimiter(delimiter), maxSize(maxSize), scanPos(0)
+{}
+
+/// <summary>
+///    :       
+/// </summary>
+/// <param name="data"> -   </param>
+/// <param name="frame"> -   ,   data </param>
+/// <param name="used"> -   data       </param>
+/// <returns> 1 -  ; 0 -   ; -1 -    </returns>
+int network::delimiterCodec_t::Next(const slice_t& data, slice_t& frame, size_t& used)
+{
+    if (delimiter.empty())
+        return -1;
+
+    if (data.size >= delimiter.size())
+    {
+        const char* end = data.data + data.size - delimiter.size() + 1; //    
+        for (const char* p = data.data + scanPos; p < end; ++p)
+        {
+            p = static_cast<const char*>(memchr(p, delimiter[0], end - p)); //    
+            if (p == nullptr)
+                break;
+            if (memcmp(p, delimiter.data(), delimiter.size()) == 0)
+            {
+                frame = slice_t(data.data, p - data.data);
+                used = frame.size + delimiter.size();
+                scanPos = 0;
+                return frame.size > maxSize ? -1 : 1;
+            }
+        }
+        //   :     ,      
+        scanPos = data.size - delimiter.size() + 1;
+    }
+
+    return data.size > maxSize + delimiter.size() ? -1 : 0;
+}
+
+/// <summary>
+///     :    
+/// </summary>
+/// <param name="data"> -  </param>
+/// <param name="size"> -   </param>
+/// <param name="out"> - ,     </param>
+void network::delimiterCodec_t::Encode(const char* data, size_t size, std::string& out) const
+{
+    out.append(data, size);
+    out.append(delimiter);
+}
+
+/// <summary>
+///           
+/// </summary>
+/// <returns>   </returns>
+std::unique_ptr<network::ABScodec> network::delimiterCodec_t::Clone() const
+{
+    return std::unique_ptr<ABScodec>(new delimiterCodec_t(delimiter, maxSize));
+}
+
+/// <summary>
+///    
+/// </summary>
+void network::delimiterCodec_t::Reset()
+{
+    scanPos = 0;
+}
+
+/// <summary>
+/// 
+/// </summary>
+/// <param name="headerSize"> -  : 1, 2, 4  8  </param>
+/// <param name="maxSize"> -    </param>
+network::fixedLengthCodec_t::fixedLengthCodec_t(size_t headerSize, size_t maxSize) :
+    headerSize(headerSize == 1 || headerSize == 2 || headerSize == 8 ? headerSize : 4),
+    maxSize(maxSize)
+{
+    if (this->headerSize < sizeof(size_t) && (maxSize >> (this->headerSize * 8)) != 0) //     
+        this->maxSize = (size_t(1) << (this->headerSize * 8)) - 1;
+}
+
+/// <summary>
+///    :   ,  
+/// </summary>
+/// <param name="data"> -   </param>
+/// <param name="frame"> -   ,   data </param>
+/// <param name="used"> -   data      </param>
+/// <returns> 1 -  ; 0 -   ; -1 -    </returns>
+int network::fixedLengthCodec_t::Next(const slice_t& data, slice_t& frame, size_t& used)
+{
+    if (data.size < headerSize)
+        return 0;
+
+    unsigned long long size = 0; //      
+    for (size_t index = 0; index < headerSize; ++index)
+        size = (size << 8) | static_cast<unsigned char>(data.data[index]);
+
+    if (size > maxSize)
+        return -1;
+    if (data.size - headerSize < size)
+        return 0;
+
+    frame = slice_t(data.data + headerSize, size_t(size));
+    used = headerSize + size_t(size);
+    return 1;
+}
+
+/// <summary>
+///     :   ,  
+/// </summary>
+/// <param name="data"> -  </param>
+/// <param name="size"> -   </param>
+/// <param name="out"> - ,     </param>
+void network::fixedLengthCodec_t::Encode(const char* data, size_t size, std::string& out) const
+{
+    for (size_t index = headerSize; index-- > 0; )
+        out.push_back(char(index < sizeof(size) ? (unsigned long long)size >> (index * 8) & 0xFF : 0));
+    out.append(data, size);
+}
+
+/// <summary>
+///       
+/// </summary>
+/// <returns>   </returns>
+std::unique_ptr<network::ABScodec> network::fixedLengthCodec_t::Clone() const
+{
+    return std::unique_ptr<ABScodec>(new fixedLengthCodec_t(headerSize, maxSize));
+}
+
+/// <summary>
+///     (  -    O(1))
+/// </summary>
+void network::fixedLengthCodec_t::Reset()
+{}
+
+/// <summary>
+/// 
+/// </summary>
+/// <param name="maxSize"> -    </param>
+network::varintCodec_t::varintCodec_t(size_t maxSize) : maxSize(maxSize)
+{}
+
+/// <summary>
+///    : varint  ,  
+/// </summary>
+/// <param name="data"> -   </param>
+/// <param name="frame"> -   ,   data </param>
+/// <param name="used"> -   data      </param>
+/// <returns> 1 -  ; 0 -   ; -1 -  varint     </returns>
+int network::varintCodec_t::Next(const slice_t& data, slice_t& frame, size_t& used)
+{
+    unsigned long long size = 0; //  
+    size_t header = 0; //  
+    for (;;)
+    {
+        if (header == data.size)
+            return 0; //     
+        if (header == 10)
+            return -1; //  64 
+        unsigned char byte = static_cast<unsigned char>(data.data[header]);
+        size |= (unsigned long long)(byte & 0x7F) << (7 * header);
+        ++header;
+        if ((byte & 0x80) == 0)
+            break;
+        if (size > maxSize)
+            return -1; //       
+    }
+
+    if (size > maxSize)
+        return -1;
+    if (data.size - header < size)
+        return 0;
+
+    frame = slice_t(data.data + header, size_t(size));
+    used = header + size_t(size);
+    return 1;
+}
+
+/// <summary>
+///     : varint  ,  
+/// </summary>
+/// <param name="data"> -  </param>
+/// <param name="size"> -   </param>
+/// <param name="out"> - ,     </param>
+void network::varintCodec_t::Encode(const char* data, size_t size, std::string& out) const
+{
+    unsigned long long value = size;
+    while (value >= 0x80)
+    {
+        out.push_back(char((value & 0x7F) | 0x80));
+        value >>= 7;
+    }
+    out.push_back(char(value));
+    out.append(data, size);
+}
+
+/// <summary>
+///       
+/// </summary>
+/// <returns>   </returns>
+std::unique_ptr<network::ABScodec> network::varintCodec_t::Clone() const
+{
+    return std::unique_ptr<ABScodec>(new varintCodec_t(maxSize));
+}
+
+/// <summary>
+///     (  -    10 )
+/// </summary>
+void network::varintCodec_t::Reset()
+{}
+
+/// <summary>
+/// 
+/// </summary>
+/// <param name="socket"> -  (  ) </param>
+/// <param name="codec"> - ,      </param>
+/// <param name="capacity"> -     </param>
+network::frameReader_t::frameReader_t(TCP_socketClient_t& socket, std::unique_ptr<ABScodec> codec, size_t capacity) :
+    socket(socket), codec(std::move(codec)), buffer(capacity), pending(0)
+{}
+
+/// <summary>
+///    .     ,   -3,
+///    ,    
+/// </summary>
+/// <param name="frame"> -  ,     </param>
+/// <returns> 0 -  ;
+///           -1 -  ;
+///           -2 -     ;
+///           -3 -     ( );
+///           -4 -    </returns>
+int network::frameReader_t::Read(slice_t& frame)
+{
+    buffer.Consume(pending); //        
+    pending = 0;
+
+    for (;;)
+    {   //   ,   :   recv    
+        int result = codec->Next(buffer.ReadSlice(), frame, pending);
+        if (result > 0)
+            return 0;
+        if (result < 0)
+        {
+            pending = 0;
+            return -4;
+        }
+
+        result = socket.Recive(buffer);
+        if (result < 0)
+            return result;
+    }
+}
+
+/// <summary>
+///     
+/// </summary>
+/// <param name="msg"> -  </param>
+/// <returns>  TCP_socketClient_t::Send </returns>
+int network::frameReader_t::Write(const std::string& msg)
+{
+    s_out.clear();
+    codec->Encode(msg.data(), msg.size(), s_out);
+    return socket.Send(s_out);
+}
@@ -0,0 +1,166 @@
+#pragma once
+#ifndef CODEC_H_
+#define CODEC_H_
+
+#include <string>
+#include <memory>
+
+#include "network.h"
+
+namespace network
+{
+    /// <summary>
+    ///    :          .
+    ///    ,        (. Clone)
+    /// </summary>
+    class ABScodec
+    {
+    public:
+        /// <summary>
+        ///       .    ,  , 
+        ///  ,     (      )    
+        /// </summary>
+        /// <param name="data"> -   </param>
+        /// <param name="frame"> -   ,   data </param>
+        /// <param name="used"> -   data     /  </param>
+        /// <returns> 1 -  ; 0 -   ; -1 -       </returns>
+        virtual int Next(const slice_t& data, slice_t& frame, size_t& used) = 0;
+
+        /// <summary>
+        ///     
+        /// </summary>
+        /// <param name="data"> -  </param>
+        /// <param name="size"> -   </param>
+        /// <param name="out"> - ,     </param>
+        virtual void Encode(const char* data, size_t size, std::string& out) const = 0;
+
+        /// <summary>
+        ///           
+        /// </summary>
+        /// <returns>   </returns>
+        virtual std::unique_ptr<ABScodec> Clone() const = 0;
+
+        /// <summary>
+        ///    
+        /// </summary>
+        virtual void Reset() = 0;
+
+        virtual ~ABScodec() {}
+    };
+
+    /// <summary>
+    ///     :      ,     
+    /// </summary>
+    class delimiterCodec_t : public ABScodec
+    {
+    public:
+        /// <summary>
+        /// 
+        /// </summary>
+        /// <param name="delimiter"> -   ,   </param>
+        /// <param name="maxSize"> -      </param>
+        delimiterCodec_t(const std::string& delimiter, size_t maxSize = 1 << 20);
+
+        int Next(const slice_t& data, slice_t& frame, size_t& used) override;
+        void Encode(const char* data, size_t size, std::string& out) const override;
+        std::unique_ptr<ABScodec> Clone() const override;
+        void Reset() override;
+
+    protected:
+        const std::string delimiter; //   
+        const size_t maxSize; //   
+        size_t scanPos; //     
+    };
+
+    /// <summary>
+    ///      :       (1, 2, 4  8 )
+    /// </summary>
+    class fixedLengthCodec_t : public ABScodec
+    {
+    public:
+        /// <summary>
+        /// 
+        /// </summary>
+        /// <param name="headerSize"> -  : 1, 2, 4  8  </param>
+        /// <param name="maxSize"> -    </param>
+        fixedLengthCodec_t(size_t headerSize = 4, size_t maxSize = 1 << 20);
+
+        int Next(const slice_t& data, slice_t& frame, size_t& used) override;
+        void Encode(const char* data, size_t size, std::string& out) const override;
+        std::unique_ptr<ABScodec> Clone() const override;
+        void Reset() override;
+
+    protected:
+        const size_t headerSize; //  
+        size_t maxSize; //    ( ,    )
+    };
+
+    /// <summary>
+    ///      :     varint ( 7 ,  )
+    /// </summary>
+    class varintCodec_t : public ABScodec
+    {
+    public:
+        /// <summary>
+        /// 
+        /// </summary>
+        /// <param name="maxSize"> -    </param>
+        varintCodec_t(size_t maxSize = 1 << 20);
+
+        int Next(const slice_t& data, slice_t& frame, size_t& used) override;
+        void Encode(const char* data, size_t size, std::string& out) const override;
+        std::unique_ptr<ABScodec> Clone() const override;
+        void Reset() override;
+
+    protected:
+        const size_t maxSize; //   
+    };
+
+    /// <summary>
+    ///    TCP :          .
+    ///   recv    ,    
+    /// </summary>
+    class frameReader_t
+    {
+    public:
+        /// <summary>
+        /// 
+        /// </summary>
+        /// <param name="socket"> -  (  ) </param>
+        /// <param name="codec"> - ,      </param>
+        /// <param name="capacity"> -     </param>
+        frameReader_t(TCP_socketClient_t& socket, std::unique_ptr<ABScodec> codec, size_t capacity = 4096);
+
+        //  -         
+        frameReader_t(const frameReader_t& reader) = delete;
+        frameReader_t& operator = (const frameReader_t& reader) = delete;
+
+        /// <summary>
+        ///    .     ,   -3,
+        ///    ,    
+        /// </summary>
+        /// <param name="frame"> -  ,     </param>
+        /// <returns> 0 -  ;
+        ///           -1 -  ;
+        ///           -2 -     ;
+        ///           -3 -     ( );
+        ///           -4 -    </returns>
+        int Read(slice_t& frame);
+
+        /// <summary>
+        ///     
+        /// </summary>
+        /// <param name="msg"> -  </param>
+        /// <returns>  TCP_socketClient_t::Send </returns>
+        int Write(const std::string& msg);
+
+    protected:
+        TCP_socketClient_t& socket; // 
+        std::unique_ptr<ABScodec> codec; // 
+        buffer_t buffer; //  
+        size_t pending; //   ,      
+        std::string s_out; //     
+    };
+};
+
+#endif /* CODEC_H_ */
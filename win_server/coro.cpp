@@ -0,0 +1,619 @@
+#include "coro.h"
+
+thread_local network::coReactor_t* network::coReactor_t::p_current = nullptr;
+
+/// <summary>
+///        
+/// </summary>
+void* network::coTask_t::promise_type::operator new(size_t size)
+{
+    return coReactor_t::AllocateFrame(size);
+}
+
+/// <summary>
+///    ,    
+/// </summary>
+void network::coTask_t::promise_type::operator delete(void* p_frame)
+{
+    coReactor_t::FreeFrame(p_frame);
+}
+
+/// <summary>
+/// 
+/// </summary>
+/// <param name="p_reactor"> - ,     </param>
+/// <param name="socket"> -   ,   </param>
+/// <param name="fd"> -   </param>
+/// <param name="write"> - 1 -     ; 0 -   </param>
+network::coOp_t::coOp_t(coReactor_t* p_reactor, const std::shared_ptr<socket_t>& socket, SOCKET fd, bool write) :
+    p_reactor(p_reactor), socket(socket), fd(fd), result(-2), write(write)
+{}
+
+/// <summary>
+///       
+/// </summary>
+/// <returns> 1 -  ,    </returns>
+bool network::coOp_t::await_ready()
+{
+    if (p_reactor == nullptr || socket == nullptr)
+        return true; //        -2
+    result = Try();
+    return result != -3;
+}
+
+/// <summary>
+///      
+/// </summary>
+/// <param name="handle"> -   </param>
+/// <returns> 1 -  ; 0 -  ,      </returns>
+bool network::coOp_t::await_suspend(std::coroutine_handle<> handle)
+{
+    this->handle = handle;
+    return p_reactor->Wait(*this);
+}
+
+network::coRecv_t::coRecv_t(coReactor_t* p_reactor, const std::shared_ptr<socket_t>& socket, SOCKET fd, const std::shared_ptr<TCP_socketClient_t>& client,
+    buffer_t* p_buffer, slice_t slice, size_t minSize) :
+    coOp_t(p_reactor, socket, fd, false), client(client), p_buffer(p_buffer), slice(slice), minSize(minSize)
+{}
+
+/// <summary>
+///  
+/// </summary>
+/// <returns>  TCP_socketClient_t::Recive </returns>
+int network::coRecv_t::Try()
+{
+    return p_buffer != nullptr ? client->Recive(*p_buffer, minSize) : client->Recive(slice);
+}
+
+network::coSend_t::coSend_t(coReactor_t* p_reactor, const std::shared_ptr<socket_t>& socket, SOCKET fd, const std::shared_ptr<TCP_socketClient_t>& client, slice_t data) :
+    coOp_t(p_reactor, socket, fd, true), client(client), remain(data)
+{}
+
+/// <summary>
+///    ,    
+/// </summary>
+/// <returns> 0 -  ; -3 -   ;   Send </returns>
+int network::coSend_t::Try()
+{
+    int result = 0;
+
+    while (remain.size != 0)
+    {
+        result = client->Send(&remain, 1);
+        if (result > 0)
+        { //    -      ( ,  ,  -3)
+            remain.data += result;
+            remain.size -= result;
+        }
+        else if (result == 0)
+            remain.size = 0;
+        else
+            break;
+    }
+
+    return result;
+}
+
+/// <summary>
+///   () 
+/// </summary>
+network::coConn_t::coConn_t() : p_reactor(nullptr), fd(INVALID_SOCKET)
+{}
+
+network::coConn_t::coConn_t(coReactor_t* p_reactor, const std::shared_ptr<TCP_socketClient_t>& client, const std::shared_ptr<socket_t>& socket, SOCKET fd) :
+    p_reactor(p_reactor), client(client), socket(socket), fd(fd), guard(std::make_shared<coConnGuard_t>(p_reactor, client, fd))
+{}
+
+/// <summary>
+///   :     -     
+/// </summary>
+network::coConnGuard_t::~coConnGuard_t()
+{
+    p_reactor->Close(client, fd);
+}
+
+/// <summary>
+///   
+/// </summary>
+/// <returns> 1 -       </returns>
+bool network::coConn_t::Valid() const
+{
+    return client != nullptr && coReactor_t::IsOpen(client);
+}
+
+/// <summary>
+///        
+/// </summary>
+/// <param name="buffer"> -  ,      </param>
+/// <param name="minSize"> -       </param>
+/// <returns>   co_await </returns>
+network::coRecv_t network::coConn_t::Recv(buffer_t& buffer, size_t minSize)
+{
+    return coRecv_t(p_reactor, socket, fd, client, &buffer, slice_t(), minSize);
+}
+
+/// <summary>
+///      
+/// </summary>
+/// <param name="buffer"> -     </param>
+/// <returns>   co_await </returns>
+network::coRecv_t network::coConn_t::Recv(slice_t buffer)
+{
+    return coRecv_t(p_reactor, socket, fd, client, nullptr, buffer, 0);
+}
+
+/// <summary>
+///    
+/// </summary>
+/// <param name="data"> -    </param>
+/// <returns>   co_await </returns>
+network::coSend_t network::coConn_t::Send(const std::string& data)
+{
+    return coSend_t(p_reactor, socket, fd, client, slice_t(const_cast<char*>(data.data()), data.size()));
+}
+
+/// <summary>
+///     
+/// </summary>
+/// <param name="data"> -    </param>
+/// <returns>   co_await </returns>
+network::coSend_t network::coConn_t::Send(slice_t data)
+{
+    return coSend_t(p_reactor, socket, fd, client, data);
+}
+
+/// <summary>
+///   :          -2
+/// </summary>
+void network::coConn_t::Close()
+{
+    if (p_reactor != nullptr && socket != nullptr)
+        p_reactor->Close(client, fd);
+}
+
+/// <summary>
+///    
+/// </summary>
+/// <returns>   , nullptr -   </returns>
+const network::sockInfo_t* network::coConn_t::GetPeer() const
+{
+    return client != nullptr ? &coReactor_t::PeerOf(client) : nullptr;
+}
+
+network::coAccept_t::coAccept_t(coReactor_t* p_reactor, const std::shared_ptr<socket_t>& socket, SOCKET fd, const std::shared_ptr<TCP_socketServer_t>& server) :
+    coOp_t(p_reactor, socket, fd, false), server(server)
+{}
+
+/// <summary>
+///   
+/// </summary>
+/// <returns> 0 -  ; -3 -    ; -1 -  ; -2 -    </returns>
+int network::coAccept_t::Try()
+{
+    if (client == nullptr)
+        client = std::make_shared<TCP_socketClient_t>(p_reactor->logger);
+
+    int result = server->AddClient(*client);
+    if (result == -2)
+        result = -3; //   -  
+    else if (result == -3)
+        result = -2;
+
+    return result;
+}
+
+/// <summary>
+///   
+/// </summary>
+/// <returns>  ,   -  </returns>
+network::coConn_t network::coAccept_t::await_resume()
+{
+    return result == 0 ? p_reactor->Adopt(client) : coConn_t();
+}
+
+/// <summary>
+///   () 
+/// </summary>
+network::coServer_t::coServer_t() : p_reactor(nullptr), fd(INVALID_SOCKET)
+{}
+
+network::coServer_t::coServer_t(coReactor_t* p_reactor, const std::shared_ptr<TCP_socketServer_t>& server, const std::shared_ptr<socket_t>& socket, SOCKET fd) :
+    p_reactor(p_reactor), server(server), socket(socket), fd(fd)
+{}
+
+/// <summary>
+///   
+/// </summary>
+/// <returns> 1 -   </returns>
+bool network::coServer_t::Valid() const
+{
+    return socket != nullptr;
+}
+
+/// <summary>
+///   
+/// </summary>
+/// <returns>   co_await </returns>
+network::coAccept_t network::coServer_t::Accept()
+{
+    return coAccept_t(p_reactor, socket, fd, server);
+}
+
+/// <summary>
+///         ( )
+/// </summary>
+std::shared_ptr<network::socket_t> network::coReactor_t::AsSocket(const std::shared_ptr<TCP_socketClient_t>& socket)
+{
+    return std::shared_ptr<socket_t>(socket, static_cast<socket_t*>(socket.get()));
+}
+
+/// <summary>
+///         ( )
+/// </summary>
+std::shared_ptr<network::socket_t> network::coReactor_t::AsSocket(const std::shared_ptr<TCP_socketServer_t>& socket)
+{
+    return std::shared_ptr<socket_t>(socket, static_cast<socket_t*>(socket.get()));
+}
+
+/// <summary>
+///     
+/// </summary>
+/// <param name="client"> -   </param>
+/// <returns>    </returns>
+const network::sockInfo_t& network::coReactor_t::PeerOf(const std::shared_ptr<TCP_socketClient_t>& client)
+{
+    return client->serverInfo;
+}
+
+/// <summary>
+///    
+/// </summary>
+/// <param name="client"> -   </param>
+/// <returns> 1 -   </returns>
+bool network::coReactor_t::IsOpen(const std::shared_ptr<TCP_socketClient_t>& client)
+{
+    return client->CheckValidSocket(false);
+}
+
+/// <summary>
+///    
+/// </summary>
+/// <param name="size"> -   </param>
+/// <returns>    </returns>
+void* network::coReactor_t::AllocateFrame(size_t size)
+{
+    //      - (nullptr - );     new,
+    //         operator new
+    const size_t HEADER = __STDCPP_DEFAULT_NEW_ALIGNMENT__;
+    size += HEADER;
+
+    slabPool_t* p_pool = nullptr;
+    void* p_record = nullptr;
+    if (p_current != nullptr)
+    {
+        size_t index = 0;
+        for (size_t recordSize = FRAME_MIN; index < FRAME_CLASSES && recordSize < size; recordSize <<= 1)
+            ++index;
+        if (index < FRAME_CLASSES)
+        {
+            p_pool = p_current->v_framePool[index].get();
+            p_record = p_pool->Allocate(size);
+        }
+    }
+    if (p_record == nullptr)
+    { //       
+        p_pool = nullptr;
+        p_record = ::operator new(size);
+    }
+
+    *static_cast<slabPool_t**>(p_record) = p_pool;
+    return static_cast<char*>(p_record) + HEADER;
+}
+
+/// <summary>
+///    
+/// </summary>
+/// <param name="p_frame"> -    AllocateFrame </param>
+void network::coReactor_t::FreeFrame(void* p_frame)
+{
+    void* p_record = static_cast<char*>(p_frame) - __STDCPP_DEFAULT_NEW_ALIGNMENT__;
+    slabPool_t* p_pool = *static_cast<slabPool_t**>(p_record);
+    if (p_pool != nullptr)
+        p_pool->Free(p_record);
+    else
+        ::operator delete(p_record);
+}
+
+/// <summary>
+/// .       Work():      
+/// </summary>
+/// <param name="logger"> -   </param>
+network::coReactor_t::coReactor_t(log_t& logger) : RAII_OSsock(logger), manager(logger), placement(placement_t::NONE), placementIndex(0), p_resolver(nullptr),
+    logger(logger)
+{
+    for (size_t index = 0; index < FRAME_CLASSES; ++index)
+        v_framePool.push_back(std::unique_ptr<slabPool_t>(new slabPool_t(FRAME_MIN << index, 64)));
+}
+
+/// <summary>
+/// :     
+/// </summary>
+network::coReactor_t::~coReactor_t()
+{
+    //   :     ,    
+    std::vector<std::coroutine_handle<>> v_handle;
+    for (std::map<int, watch_t>::iterator iter = m_readers.begin(); iter != m_readers.end(); ++iter)
+        if (iter->second.p_op != nullptr)
+        {
+            v_handle.push_back(iter->second.p_op->handle);
+            iter->second.p_op = nullptr;
+        }
+    for (std::map<int, watch_t>::iterator iter = m_senders.begin(); iter != m_senders.end(); ++iter)
+        if (iter->second.p_op != nullptr)
+        {
+            v_handle.push_back(iter->second.p_op->handle);
+            iter->second.p_op = nullptr;
+        }
+    for (std::deque<coOp_t*>::iterator iter = d_cancelled.begin(); iter != d_cancelled.end(); ++iter)
+        v_handle.push_back((*iter)->handle);
+    d_cancelled.clear();
+    //     ,     ;     
+    //      
+    for (size_t index = 0; index < v_handle.size(); ++index)
+        v_handle[index].destroy();
+    //        
+    SetResolver(nullptr);
+    for (std::map<int, watch_t>::iterator iter = m_readers.begin(); iter != m_readers.end(); ++iter)
+        manager.deleteReader(iter->second.socket);
+    for (std::map<int, watch_t>::iterator iter = m_senders.begin(); iter != m_senders.end(); ++iter)
+        manager.deleteSender(iter->second.socket);
+    m_readers.clear();
+    m_senders.clear();
+
+    if (p_current == this)
+        p_current = nullptr;
+}
+
+/// <summary>
+///    ,     
+/// </summary>
+/// <param name="client"> -   (,  ) </param>
+/// <returns>  ,  -    </returns>
+network::coConn_t network::coReactor_t::Adopt(std::shared_ptr<TCP_socketClient_t> client)
+{
+    coConn_t result;
+
+    if (client != nullptr && client->CheckValidSocket())
+    {
+        if (client->setNonBlock()) //       ,     
+            result = coConn_t(this, client, AsSocket(client), client->getSocket());
+        else
+            logger.doLog("coReactor_t::Adopt() fail - setNonBlock");
+    }
+
+    return result;
+}
+
+/// <summary>
+///     ,     
+/// </summary>
+/// <param name="server"> -  ,       </param>
+/// <returns>  ,  -    </returns>
+network::coServer_t network::coReactor_t::Listen(std::shared_ptr<TCP_socketServer_t> server)
+{
+    coServer_t result;
+
+    if (server != nullptr && server->CheckValidSocket())
+    {
+        if (server->setNonBlock())
+            result = coServer_t(this, server, AsSocket(server), server->getSocket());
+        else
+            logger.doLog("coReactor_t::Listen() fail - setNonBlock");
+    }
+
+    return result;
+}
+
+/// <summary>
+///       
+/// </summary>
+/// <param name="op"> -  </param>
+/// <returns> 1 -  ; 0 - ,    </returns>
+bool network::coReactor_t::Wait(coOp_t& op)
+{
+    bool result = false;
+    std::map<int, watch_t>& m_watch = op.write ? m_senders : m_readers;
+    int fd = op.fd;
+
+    std::map<int, watch_t>::iterator iter = m_watch.find(fd);
+    if (iter == m_watch.end())
+    { //       
+        if (op.write ? manager.AddSender(op.socket) : manager.AddReader(op.socket))
+        {
+            watch_t& watch = m_watch[fd];
+            watch.socket = op.socket;
+            watch.p_op = &op;
+            result = true;
+        }
+        else
+            logger.doLog("coReactor_t::Wait() fail - manager");
+    }
+    else if (iter->second.p_op == nullptr)
+    {
+        iter->second.p_op = &op;
+        result = true;
+    }
+    else //         
+        logger.doLog("coReactor_t::Wait() fail - socket is busy ", fd);
+
+    if (!result)
+        op.result = -1;
+
+    return result;
+}
+
+/// <summary>
+///      
+/// </summary>
+/// <param name="m_watch"> -    </param>
+/// <param name="fd"> -    </param>
+/// <param name="write"> -  </param>
+void network::coReactor_t::Ready(std::map<int, watch_t>& m_watch, int fd, bool write)
+{
+    std::map<int, watch_t>::iterator iter = m_watch.find(fd);
+    if (iter != m_watch.end()) //    ,     
+    {
+        coOp_t* p_op = iter->second.p_op;
+        if (p_op == nullptr)
+        { //   -   ,        
+            if (write)
+                manager.deleteSender(iter->second.socket);
+            else
+                manager.deleteReader(iter->second.socket);
+            m_watch.erase(iter);
+        }
+        else if ((p_op->result = p_op->Try()) != -3)
+        { //    : ,  ,     
+            iter->second.p_op = nullptr;
+            p_op->handle.resume();
+        }
+    }
+}
+
+/// <summary>
+///     ,      -2   
+/// </summary>
+/// <param name="fd"> -   </param>
+void network::coReactor_t::Forget(int fd)
+{
+    std::map<int, watch_t>::iterator iter = m_readers.find(fd);
+    if (iter != m_readers.end())
+    {
+        if (iter->second.p_op != nullptr)
+        {
+            iter->second.p_op->result = -2;
+            d_cancelled.push_back(iter->second.p_op);
+        }
+        manager.deleteReader(iter->second.socket);
+        m_readers.erase(iter);
+    }
+
+    iter = m_senders.find(fd);
+    if (iter != m_senders.end())
+    {
+        if (iter->second.p_op != nullptr)
+        {
+            iter->second.p_op->result = -2;
+            d_cancelled.push_back(iter->second.p_op);
+        }
+        manager.deleteSender(iter->second.socket);
+        m_senders.erase(iter);
+    }
+}
+
+/// <summary>
+///   :      
+/// </summary>
+/// <param name="client"> -   </param>
+/// <param name="fd"> -   </param>
+void network::coReactor_t::Close(const std::shared_ptr<TCP_socketClient_t>& client, SOCKET fd)
+{
+    if (client->CheckValidSocket(false)) //        
+    {
+        Forget(fd); //      
+        client->Close(); //        
+    }
+}
+
+/// <summary>
+///   :     ,   
+/// </summary>
+/// <param name="timeOut"> -      </param>
+/// <returns> 1 -      </returns>
+bool network::coReactor_t::Work(const int timeOut)
+{
+    p_current = this; // ,   ,      
+    bool result = manager.Work(!d_cancelled.empty() ? 0 : p_resolver != nullptr ? p_resolver->GetWait(timeOut) : timeOut);
+
+    if (result)
+    { //  :    
+        v_ready.clear();
+        const std::map<int, std::shared_ptr<socket_t>>& m_sender = manager.GetReadySenders();
+        for (std::map<int, std::shared_ptr<socket_t>>::const_iterator iter = m_sender.begin(); iter != m_sender.end(); ++iter)
+            v_ready.push_back(std::make_pair(iter->first, true));
+        const std::map<int, std::shared_ptr<socket_t>>& m_reader = manager.GetReadyReaders();
+        for (std::map<int, std::shared_ptr<socket_t>>::const_iterator iter = m_reader.begin(); iter != m_reader.end(); ++iter)
+            v_ready.push_back(std::make_pair(iter->first, false));
+
+        for (size_t index = 0; index < v_ready.size(); ++index)
+            Ready(v_ready[index].second ? m_senders : m_readers, v_ready[index].first, v_ready[index].second);
+    }
+    if (p_resolver != nullptr) //  DNS    ;    
+        p_resolver->Work(0);
+
+    while (!d_cancelled.empty())
+    { //       -    
+        coOp_t* p_op = d_cancelled.front();
+        d_cancelled.pop_front();
+        p_op->handle.resume();
+    }
+
+    return result;
+}
+
+/// <summary>
+///      
+/// </summary>
+/// <param name="stop"> -   </param>
+void network::coReactor_t::Run(const volatile std::atomic_bool& stop)
+{
+    if (placement != placement_t::NONE) //    ,     , -   
+        PlaceThread(placement, placementIndex);
+    while (!stop)
+        Work(100); //      
+    if (p_current == this) //        -        
+        p_current = nullptr;
+}
+
+/// <summary>
+///          NUMA:   Run()   
+/// </summary>
+/// <param name="policy"> -  placement_t </param>
+/// <param name="index"> -      (      NUMA) </param>
+void network::coReactor_t::SetPlacement(int policy, unsigned index)
+{
+    placement = policy;
+    placementIndex = index;
+}
+
+/// <summary>
+///    DNS:       ,     
+///        Work(0) -  Resolve     .
+/// Resolve      ;   ,  
+/// </summary>
+/// <param name="resolver"> -  DNS, nullptr -  </param>
+void network::coReactor_t::SetResolver(dnsResolver_t* resolver)
+{
+    if (p_resolver != nullptr)
+        manager.deleteReader(p_resolver->GetSocket());
+    p_resolver = resolver;
+    if (p_resolver != nullptr && !manager.AddReader(p_resolver->GetSocket()))
+        logger.doLog("coReactor_t - resolver socket not added");
+}
+
+/// <summary>
+///    ,   
+/// </summary>
+/// <returns>    </returns>
+size_t network::coReactor_t::GetWaitingCount() const
+{
+    size_t result = 0;
+    for (std::map<int, watch_t>::const_iterator iter = m_readers.begin(); iter != m_readers.end(); ++iter)
+        if (iter->second.p_op != nullptr)
+            ++result;
+    for (std::map<int, watch_t>::const_iterator iter = m_senders.begin(); iter != m_senders.end(); ++iter)
+        if (iter->second.p_op != nullptr)
+            ++result;
+    return result;
+}
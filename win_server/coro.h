@@ -0,0 +1,435 @@
+#pragma once
+#ifndef CORO_H_
+#define CORO_H_
+
+#include <coroutine>
+#include <exception>
+#include <atomic>
+#include <deque>
+#include <vector>
+
+#include "network.h"
+#include "buffer.h"
+#include "slab.h"
+#include "topology.h"
+#include "dns.h"
+
+namespace network
+{
+    class coReactor_t;
+
+    /// <summary>
+    /// -  :         ,     .
+    ///       coReactor_t,     (   -  ).
+    /// : coTask_t Echo(coConn_t conn) { ... int size = co_await conn.Recv(buffer); ... co_await conn.Send(answer); }
+    /// </summary>
+    class coTask_t
+    {
+    public:
+        /// <summary>
+        ///   ( )
+        /// </summary>
+        struct promise_type
+        {
+            coTask_t get_return_object() { return coTask_t(); }
+            std::suspend_never initial_suspend() noexcept { return {}; }
+            std::suspend_never final_suspend() noexcept { return {}; } //     
+            void return_void() {}
+            void unhandled_exception() { std::terminate(); } //    ,    
+
+            /// <summary>
+            ///        
+            /// </summary>
+            static void* operator new(size_t size);
+
+            /// <summary>
+            ///    ,    
+            /// </summary>
+            static void operator delete(void* p_frame);
+        };
+    };
+
+    /// <summary>
+    ///      .       
+    ///      " " (-3),        
+    /// </summary>
+    class coOp_t
+    {
+        friend class coReactor_t; //      
+    public:
+        bool await_ready();
+        bool await_suspend(std::coroutine_handle<> handle);
+
+    protected:
+        /// <summary>
+        /// 
+        /// </summary>
+        /// <param name="p_reactor"> - ,     </param>
+        /// <param name="socket"> -   ,   </param>
+        /// <param name="fd"> -   </param>
+        /// <param name="write"> - 1 -     ; 0 -   </param>
+        coOp_t(coReactor_t* p_reactor, const std::shared_ptr<socket_t>& socket, SOCKET fd, bool write);
+
+        /// <summary>
+        ///   
+        /// </summary>
+        /// <returns>  , -3 -   ,   </returns>
+        virtual int Try() = 0;
+
+        virtual ~coOp_t() {}
+
+        coReactor_t* p_reactor; //  
+        std::shared_ptr<socket_t> socket; //  
+        SOCKET fd; //  
+        std::coroutine_handle<> handle; //  
+        int result; //   
+        bool write; //  
+    };
+
+    /// <summary>
+    ///   : co_await   TCP_socketClient_t::Recive (N>0 -  N ;
+    /// -1 -  ; -2 -  )
+    /// </summary>
+    class coRecv_t : public coOp_t
+    {
+        friend class coConn_t;
+    public:
+        int await_resume() const { return result; }
+    protected:
+        coRecv_t(coReactor_t* p_reactor, const std::shared_ptr<socket_t>& socket, SOCKET fd, const std::shared_ptr<TCP_socketClient_t>& client,
+            buffer_t* p_buffer, slice_t slice, size_t minSize);
+
+        int Try() override;
+
+        std::shared_ptr<TCP_socketClient_t> client; //  
+        buffer_t* p_buffer; //   (nullptr -   )
+        slice_t slice; //   
+        size_t minSize; //     
+    };
+
+    /// <summary>
+    ///    : co_await  0 -  ; -1 -  ; -2 -  .
+    ///      co_await (    co_await )
+    /// </summary>
+    class coSend_t : public coOp_t
+    {
+        friend class coConn_t;
+    public:
+        int await_resume() const { return result; }
+    protected:
+        coSend_t(coReactor_t* p_reactor, const std::shared_ptr<socket_t>& socket, SOCKET fd, const std::shared_ptr<TCP_socketClient_t>& client, slice_t data);
+
+        int Try() override;
+
+        std::shared_ptr<TCP_socketClient_t> client; //  
+        slice_t remain; //     
+    };
+
+    /// <summary>
+    ///    coConn_t:            .
+    ///       ,     
+    /// </summary>
+    struct coConnGuard_t
+    {
+        coConnGuard_t(coReactor_t* p_reactor, const std::shared_ptr<TCP_socketClient_t>& client, SOCKET fd) : p_reactor(p_reactor), client(client), fd(fd)
+        {}
+        ~coConnGuard_t();
+
+        coReactor_t* p_reactor; //  
+        std::shared_ptr<TCP_socketClient_t> client; //  
+        SOCKET fd; //  
+    };
+
+    /// <summary>
+    ///    coReactor_t.   :     ,
+    ///    Close()     
+    /// </summary>
+    class coConn_t
+    {
+        friend class coReactor_t;
+    public:
+        /// <summary>
+        ///   () 
+        /// </summary>
+        coConn_t();
+
+        /// <summary>
+        ///   
+        /// </summary>
+        /// <returns> 1 -       </returns>
+        bool Valid() const;
+
+        /// <summary>
+        ///        
+        /// </summary>
+        /// <param name="buffer"> -  ,      </param>
+        /// <param name="minSize"> -       </param>
+        /// <returns>   co_await </returns>
+        coRecv_t Recv(buffer_t& buffer, size_t minSize = 2048);
+
+        /// <summary>
+        ///      
+        /// </summary>
+        /// <param name="buffer"> -     </param>
+        /// <returns>   co_await </returns>
+        coRecv_t Recv(slice_t buffer);
+
+        /// <summary>
+        ///    
+        /// </summary>
+        /// <param name="data"> -    </param>
+        /// <returns>   co_await </returns>
+        coSend_t Send(const std::string& data);
+
+        /// <summary>
+        ///     
+        /// </summary>
+        /// <param name="data"> -    </param>
+        /// <returns>   co_await </returns>
+        coSend_t Send(slice_t data);
+
+        /// <summary>
+        ///   :          -2
+        /// </summary>
+        void Close();
+
+        /// <summary>
+        ///    
+        /// </summary>
+        /// <returns>   , nullptr -   </returns>
+        const sockInfo_t* GetPeer() const;
+
+    protected:
+        coConn_t(coReactor_t* p_reactor, const std::shared_ptr<TCP_socketClient_t>& client, const std::shared_ptr<socket_t>& socket, SOCKET fd);
+
+        coReactor_t* p_reactor; //  
+        std::shared_ptr<TCP_socketClient_t> client; //  
+        std::shared_ptr<socket_t> socket; //    ,  
+        SOCKET fd; //  
+        std::shared_ptr<coConnGuard_t> guard; //   ,      
+    };
+
+    /// <summary>
+    ///   : co_await    ,   - 
+    /// </summary>
+    class coAccept_t : public coOp_t
+    {
+        friend class coServer_t;
+    public:
+        coConn_t await_resume();
+    protected:
+        coAccept_t(coReactor_t* p_reactor, const std::shared_ptr<socket_t>& socket, SOCKET fd, const std::shared_ptr<TCP_socketServer_t>& server);
+
+        int Try() override;
+
+        std::shared_ptr<TCP_socketServer_t> server; //  
+        std::shared_ptr<TCP_socketClient_t> client; //    ,   
+    };
+
+    /// <summary>
+    ///     coReactor_t.   
+    /// </summary>
+    class coServer_t
+    {
+        friend class coReactor_t;
+    public:
+        /// <summary>
+        ///   () 
+        /// </summary>
+        coServer_t();
+
+        /// <summary>
+        ///   
+        /// </summary>
+        /// <returns> 1 -   </returns>
+        bool Valid() const;
+
+        /// <summary>
+        ///   
+        /// </summary>
+        /// <returns>   co_await </returns>
+        coAccept_t Accept();
+
+    protected:
+        coServer_t(coReactor_t* p_reactor, const std::shared_ptr<TCP_socketServer_t>& server, const std::shared_ptr<socket_t>& socket, SOCKET fd);
+
+        coReactor_t* p_reactor; //  
+        std::shared_ptr<TCP_socketServer_t> server; //  
+        std::shared_ptr<socket_t> socket; //    ,  
+        SOCKET fd; //  
+    };
+
+    /// <summary>
+    ///    :   co_await    Work()  
+    ///  ,             .
+    ///   -  : ,        ,   Work().
+    ///  ,     (    ,  ),   
+    ///    ; ,    Work()    ,    .
+    ///         ,    ,   :
+    ///   --       
+    /// </summary>
+    class coReactor_t : private RAII_OSsock
+    {
+        friend class coOp_t; //    
+        friend class coConn_t; //  
+        friend class coAccept_t; //   
+        friend struct coTask_t::promise_type; //     
+        friend struct coConnGuard_t; //       
+    protected:
+        /// <summary>
+        ///    
+        /// </summary>
+        struct watch_t
+        {
+            std::shared_ptr<socket_t> socket; // 
+            coOp_t* p_op; //  , nullptr -  ,   
+        };
+
+        /// <summary>
+        ///       
+        /// </summary>
+        /// <param name="op"> -  </param>
+        /// <returns> 1 -  ; 0 - ,    </returns>
+        bool Wait(coOp_t& op);
+
+        /// <summary>
+        ///      
+        /// </summary>
+        /// <param name="m_watch"> -    </param>
+        /// <param name="fd"> -    </param>
+        /// <param name="write"> -  </param>
+        void Ready(std::map<int, watch_t>& m_watch, int fd, bool write);
+
+        /// <summary>
+        ///     ,      -2   
+        /// </summary>
+        /// <param name="fd"> -   </param>
+        void Forget(int fd);
+
+        /// <summary>
+        ///   :      
+        /// </summary>
+        /// <param name="client"> -   </param>
+        /// <param name="fd"> -   </param>
+        void Close(const std::shared_ptr<TCP_socketClient_t>& client, SOCKET fd);
+
+        /// <summary>
+        ///     
+        /// </summary>
+        /// <param name="client"> -   </param>
+        /// <returns>    </returns>
+        static const sockInfo_t& PeerOf(const std::shared_ptr<TCP_socketClient_t>& client);
+
+        /// <summary>
+        ///    
+        /// </summary>
+        /// <param name="client"> -   </param>
+        /// <returns> 1 -   </returns>
+        static bool IsOpen(const std::shared_ptr<TCP_socketClient_t>& client);
+
+        /// <summary>
+        ///    
+        /// </summary>
+        /// <param name="size"> -   </param>
+        /// <returns>    </returns>
+        static void* AllocateFrame(size_t size);
+
+        /// <summary>
+        ///    
+        /// </summary>
+        /// <param name="p_frame"> -    AllocateFrame </param>
+        static void FreeFrame(void* p_frame);
+
+        /// <summary>
+        ///         ( )
+        /// </summary>
+        static std::shared_ptr<socket_t> AsSocket(const std::shared_ptr<TCP_socketClient_t>& socket);
+
+        /// <summary>
+        ///         ( )
+        /// </summary>
+        static std::shared_ptr<socket_t> AsSocket(const std::shared_ptr<TCP_socketServer_t>& socket);
+
+    public:
+        /// <summary>
+        /// .       Work():      ,    
+        /// </summary>
+        /// <param name="logger"> -   </param>
+        coReactor_t(log_t& logger);
+
+        //  -        
+        coReactor_t(const coReactor_t& reactor) = delete;
+        coReactor_t& operator = (const coReactor_t& reactor) = delete;
+
+        /// <summary>
+        /// :     
+        /// </summary>
+        virtual ~coReactor_t();
+
+        /// <summary>
+        ///    ,     
+        /// </summary>
+        /// <param name="client"> -   (,  ) </param>
+        /// <returns>  ,  -    </returns>
+        coConn_t Adopt(std::shared_ptr<TCP_socketClient_t> client);
+
+        /// <summary>
+        ///     ,     
+        /// </summary>
+        /// <param name="server"> -  ,       </param>
+        /// <returns>  ,  -    </returns>
+        coServer_t Listen(std::shared_ptr<TCP_socketServer_t> server);
+
+        /// <summary>
+        ///   :     ,   
+        /// </summary>
+        /// <param name="timeOut"> -      </param>
+        /// <returns> 1 -      </returns>
+        bool Work(const int timeOut);
+
+        /// <summary>
+        ///      
+        /// </summary>
+        /// <param name="stop"> -   </param>
+        void Run(const volatile std::atomic_bool& stop);
+
+        /// <summary>
+        ///          NUMA:   Run()   
+        /// </summary>
+        /// <param name="policy"> -  placement_t </param>
+        /// <param name="index"> -      (      NUMA) </param>
+        void SetPlacement(int policy, unsigned index);
+
+        /// <summary>
+        ///    DNS:       ,     
+        ///        Work(0) -  Resolve     .
+        /// Resolve      ;   ,  
+        /// </summary>
+        /// <param name="resolver"> -  DNS, nullptr -  </param>
+        void SetResolver(dnsResolver_t* resolver);
+
+        /// <summary>
+        ///    ,   
+        /// </summary>
+        /// <returns>    </returns>
+        size_t GetWaitingCount() const;
+
+        static const size_t FRAME_MIN = 256; //     ,     
+        static const size_t FRAME_CLASSES = 5; //     (    )
+    protected:
+        NonBlockSocket_manager_t manager; //   
+        std::map<int, watch_t> m_readers; //   ( ),  -  
+        std::map<int, watch_t> m_senders; //  ,  -  
+        std::deque<coOp_t*> d_cancelled; //   ,     -2
+        std::vector<std::pair<int, bool>> v_ready; //      ,   
+        std::vector<std::unique_ptr<slabPool_t>> v_framePool; //     
+        int placement; //    
+        unsigned placementIndex; //      
+        dnsResolver_t* p_resolver; //  DNS,  
+        log_t& logger; //  
+
+        static thread_local coReactor_t* p_current; //   ,   Work()
+    };
+};
+
+#endif /* CORO_H_ */
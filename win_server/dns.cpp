@@ -0,0 +1,541 @@
+#include "dns.h"
+
+#include <climits>
+#include <cctype>
+#include <cstring>
+
+namespace
+{
+    const unsigned short DNS_TYPE_A = 1; //  IPv4
+    const unsigned short DNS_TYPE_SOA = 6; //  ,    
+    const unsigned short DNS_TYPE_AAAA = 28; //  IPv6
+    const unsigned short DNS_CLASS_IN = 1; //  
+    const unsigned char DNS_RCODE_NXDOMAIN = 3; //   
+    const size_t DNS_HEADER_SIZE = 12; //   
+    const size_t DNS_PACKET_MAX = 512; // UDP   EDNS  
+
+    /// <summary>
+    ///  16-     
+    /// </summary>
+    inline unsigned short Read16(const unsigned char* data)
+    {
+        return (unsigned short)((data[0] << 8) | data[1]);
+    }
+
+    /// <summary>
+    ///  32-     
+    /// </summary>
+    inline unsigned Read32(const unsigned char* data)
+    {
+        return (unsigned(data[0]) << 24) | (unsigned(data[1]) << 16) | (unsigned(data[2]) << 8) | unsigned(data[3]);
+    }
+}
+
+/// <summary>
+/// 
+/// </summary>
+/// <param name="server"> -   DNS (,  ) </param>
+/// <param name="logger"> -   </param>
+network::dnsResolver_t::dnsResolver_t(const sockInfo_t& server, log_t& logger) : RAII_OSsock(logger), server(logger), manager(logger),
+    random(std::random_device()()), result(logger), timeOut(1000), attempts(3), negativeTTL(30), maxTTL(86400), lastReqID(0), logger(logger)
+{
+    this->server.setSockInfo(server);
+    socket = std::make_shared<UDP_socket_t>(this->server.GetFamily(), logger);
+    if (!BindRandomPort())
+        logger.doLog("dnsResolver_t - random port not bound, the system will choose the port");
+    if (!manager.AddReader(socket)) // AddReader     
+        logger.doLog("dnsResolver_t - AddReader fail");
+}
+
+/// <summary>
+///       :    ID    
+/// ,   
+/// </summary>
+/// <returns> 1 -   </returns>
+bool network::dnsResolver_t::BindRandomPort()
+{
+    const char* any = (server.GetFamily() == AF_INET6) ? "::" : "0.0.0.0";
+    //     -   ;    
+    for (int attempt = 0; attempt < 8; ++attempt)
+        if (socket->Bind(any, (unsigned short)(1024 + random() % (65536 - 1024))))
+            return true;
+
+    return false;
+}
+
+/// <summary>
+/// 
+/// </summary>
+/// <param name="ip_server"> - IP   DNS   "..."  IPv6 </param>
+/// <param name="port_server"> -  ,  53 </param>
+/// <param name="logger"> -   </param>
+network::dnsResolver_t::dnsResolver_t(std::string ip_server, unsigned short port_server, log_t& logger) : dnsResolver_t(sockInfo_t(ip_server, port_server, logger), logger)
+{}
+
+network::dnsResolver_t::~dnsResolver_t()
+{
+    manager.deleteReader(socket);
+}
+
+/// <summary>
+///      :  ,   
+/// </summary>
+/// <param name="name"> -   </param>
+/// <returns> 1 -   ( 1..63 ,   253) </returns>
+bool network::dnsResolver_t::Normalize(std::string& name)
+{
+    if (!name.empty() && name.back() == '.')
+        name.pop_back();
+    if (name.empty() || name.size() > 253)
+        return false;
+
+    size_t label = 0; //   
+    for (size_t index = 0; index < name.size(); ++index)
+    {
+        if (name[index] == '.')
+        {
+            if (label == 0)
+                return false;
+            label = 0;
+        }
+        else if (++label > 63)
+            return false;
+        name[index] = char(tolower((unsigned char)name[index]));
+    }
+
+    return label != 0;
+}
+
+/// <summary>
+///   .  IP      ,     
+/// ( ,  ,   ),      Work()
+/// </summary>
+/// <param name="name"> -    IP </param>
+/// <param name="port"> - ,       </param>
+/// <param name="addr"> -     0 </param>
+/// <param name="handler"> -     N>0,      </param>
+/// <param name="af"> -  : AF_INET -  A, AF_INET6 -  AAAA </param>
+/// <returns> 0 -    addr;
+///           N>0 - ID ,    handler.OnResolve;
+///           -1 -    (   );
+///           -2 -       </returns>
+int network::dnsResolver_t::Resolve(const std::string& name, unsigned short port, sockInfo_t& addr, ABSdnsHandler& handler, int af)
+{
+    in6_addr binary; //  IP  DNS  
+    if (inet_pton(AF_INET, name.c_str(), &binary) == 1 || inet_pton(AF_INET6, name.c_str(), &binary) == 1)
+        return addr.setSockInfo(name, port) ? 0 : -2;
+
+    std::string normName(name);
+    if (!Normalize(normName))
+    {
+        logger.doLog("dnsResolver_t - invalid name: " + name);
+        return -2;
+    }
+    s_key.assign(1, af == AF_INET6 ? '6' : '4');
+    s_key.append(normName);
+
+    std::unordered_map<std::string, cacheEntry_t>::iterator cached = m_cache.find(s_key);
+    if (cached != m_cache.end())
+    {
+        if (cached->second.expires > std::chrono::steady_clock::now())
+        {
+            if (cached->second.v_addr.empty())
+                return -1;
+            Take(cached->second, port, addr);
+            return 0;
+        }
+        m_cache.erase(cached);
+    }
+
+    waiter_t waiter;
+    waiter.handler = &handler;
+    waiter.port = port;
+    waiter.reqID = lastReqID = (lastReqID == INT_MAX) ? 1 : lastReqID + 1;
+
+    std::unordered_map<std::string, unsigned short>::iterator inflight = m_inflight.find(s_key);
+    if (inflight != m_inflight.end())
+    { //    -    
+        m_pending[inflight->second].v_waiters.push_back(waiter);
+        return waiter.reqID;
+    }
+
+    unsigned short id = 0;
+    do
+        id = (unsigned short)random();
+    while (m_pending.count(id) != 0);
+
+    query_t query;
+    query.key = s_key;
+    query.attempts = 0;
+    query.v_waiters.push_back(waiter);
+    // : ID,  ,  
+    unsigned short qtype = (af == AF_INET6) ? DNS_TYPE_AAAA : DNS_TYPE_A;
+    const char header[DNS_HEADER_SIZE] = { char(id >> 8), char(id & 0xFF), 0x01, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 };
+    query.packet.reserve(DNS_HEADER_SIZE + normName.size() + 6);
+    query.packet.assign(header, DNS_HEADER_SIZE);
+    size_t begin = 0; //  :   
+    while (begin < normName.size())
+    {
+        size_t end = normName.find('.', begin);
+        if (end == std::string::npos)
+            end = normName.size();
+        query.packet.push_back(char(end - begin));
+        query.packet.append(normName, begin, end - begin);
+        begin = end + 1;
+    }
+    const char question[5] = { 0x00, char(qtype >> 8), char(qtype & 0xFF), char(DNS_CLASS_IN >> 8), char(DNS_CLASS_IN & 0xFF) };
+    query.packet.append(question, sizeof(question));
+
+    if (!Send(query))
+        return -2;
+
+    m_inflight[s_key] = id;
+    m_pending[id] = std::move(query);
+    return waiter.reqID;
+}
+
+/// <summary>
+///    (   )
+/// </summary>
+/// <param name="query"> -  </param>
+/// <returns> 1 -    </returns>
+bool network::dnsResolver_t::Send(query_t& query)
+{
+    int sent = socket->SendTo(query.packet, server);
+    //      -   
+    query.deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeOut);
+    ++query.attempts;
+    if (sent != 0 && sent != -3)
+        logger.doLog("dnsResolver_t - send query fail ", sent);
+    return sent == 0 || sent == -3;
+}
+
+/// <summary>
+///  :  ,     
+/// </summary>
+/// <param name="timeOut"> -     , 0 -   (     ) </param>
+/// <returns> 1 -       </returns>
+bool network::dnsResolver_t::Work(const int timeOut)
+{
+    bool result = false;
+
+    if (manager.Work(GetWait(timeOut)) && manager.GetReadyReader(socket))
+    {
+        char buffer[DNS_PACKET_MAX];
+        int size = 0;
+        while ((size = socket->RecvFrom(slice_t(buffer, sizeof(buffer)))) > 0)
+            if (socket->GetLastCommunication() == server) //    
+            {
+                Answer(reinterpret_cast<const unsigned char*>(buffer), size_t(size));
+                result = true;
+            }
+    }
+
+    CheckTimeouts();
+    return result;
+}
+
+/// <summary>
+///       ,   :    
+/// </summary>
+/// <param name="timeOut"> -     , -1 -  </param>
+/// <returns>     </returns>
+int network::dnsResolver_t::GetWait(const int timeOut) const
+{
+    int wait = timeOut;
+    if (!m_pending.empty() && wait != 0)
+    { //     
+        std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+        for (std::map<unsigned short, query_t>::const_iterator iter = m_pending.begin(); iter != m_pending.end(); ++iter)
+        {
+            //  ,        
+            long long left = std::chrono::duration_cast<std::chrono::milliseconds>(iter->second.deadline - now + std::chrono::microseconds(999)).count();
+            if (left < 0)
+                left = 0;
+            if (wait < 0 || left < wait)
+                wait = int(left);
+        }
+    }
+
+    return wait;
+}
+
+/// <summary>
+///     -           
+/// (   GetWait)  Work(0)
+/// </summary>
+/// <returns>   </returns>
+std::shared_ptr<network::socket_t> network::dnsResolver_t::GetSocket() const
+{
+    return socket;
+}
+
+/// <summary>
+///      DNS (  )
+/// </summary>
+/// <param name="data"> -  </param>
+/// <param name="size"> -   </param>
+/// <param name="pos"> -  ,   -    </param>
+/// <returns> 1 -   </returns>
+bool network::dnsResolver_t::SkipName(const unsigned char* data, size_t size, size_t& pos)
+{
+    while (pos < size)
+    {
+        unsigned char length = data[pos];
+        if (length == 0)
+        {
+            ++pos;
+            return true;
+        }
+        if ((length & 0xC0) == 0xC0) //        
+        {
+            pos += 2;
+            return pos <= size;
+        }
+        if ((length & 0xC0) != 0)
+            return false;
+        pos += size_t(length) + 1;
+    }
+
+    return false;
+}
+
+/// <summary>
+///    
+/// </summary>
+/// <param name="data"> -   </param>
+/// <param name="size"> -   </param>
+void network::dnsResolver_t::Answer(const unsigned char* data, size_t size)
+{
+    if (size < DNS_HEADER_SIZE)
+        return;
+
+    unsigned short id = Read16(data);
+    std::map<unsigned short, query_t>::iterator pending = m_pending.find(id);
+    if (pending == m_pending.end() || (data[2] & 0x80) == 0) //       
+        return;
+    //     ,      
+    const std::string& packet = pending->second.packet;
+    size_t questionSize = packet.size() - DNS_HEADER_SIZE;
+    if (Read16(data + 4) != 1 || size < packet.size())
+        return;
+    for (size_t index = DNS_HEADER_SIZE; index < packet.size(); ++index)
+        if (tolower(data[index]) != tolower((unsigned char)packet[index]))
+            return;
+
+    std::vector<sockaddr_storage> v_addr;
+    if ((data[2] & 0x02) != 0) //   -  TCP  
+    {
+        logger.doLog("dnsResolver_t - truncated answer: " + pending->second.key.substr(1));
+        Finish(id, -3, v_addr, 0);
+        return;
+    }
+
+    unsigned char rcode = data[3] & 0x0F;
+    if (rcode != 0 && rcode != DNS_RCODE_NXDOMAIN)
+    { //     -    
+        logger.doLog("dnsResolver_t - server error: " + pending->second.key.substr(1) + " rcode ", rcode);
+        Finish(id, -3, v_addr, 0);
+        return;
+    }
+
+    unsigned short qtype = pending->second.key[0] == '6' ? DNS_TYPE_AAAA : DNS_TYPE_A;
+    unsigned answers = Read16(data + 6);
+    unsigned authority = Read16(data + 8);
+    unsigned ttl = maxTTL;
+    unsigned negative = negativeTTL;
+    size_t pos = DNS_HEADER_SIZE + questionSize;
+
+    for (unsigned record = 0; record < answers + authority; ++record)
+    {
+        if (!SkipName(data, size, pos) || pos + 10 > size)
+        {
+            logger.doLog("dnsResolver_t - malformed answer: " + pending->second.key.substr(1));
+            Finish(id, -3, std::vector<sockaddr_storage>(), 0);
+            return;
+        }
+        unsigned short type = Read16(data + pos);
+        unsigned short rclass = Read16(data + pos + 2);
+        unsigned recordTTL = Read32(data + pos + 4);
+        size_t length = Read16(data + pos + 8);
+        pos += 10;
+        if (pos + length > size)
+        {
+            logger.doLog("dnsResolver_t - malformed answer: " + pending->second.key.substr(1));
+            Finish(id, -3, std::vector<sockaddr_storage>(), 0);
+            return;
+        }
+
+        if (record < answers && rclass == DNS_CLASS_IN && type == qtype)
+        { // CNAME   -        
+            sockaddr_storage addr;
+            memset(&addr, 0, sizeof(addr));
+            if (type == DNS_TYPE_A && length == 4)
+            {
+                addr.ss_family = AF_INET;
+                memcpy(&reinterpret_cast<sockaddr_in*>(&addr)->sin_addr, data + pos, 4);
+                v_addr.push_back(addr);
+            }
+            else if (type == DNS_TYPE_AAAA && length == 16)
+            {
+                addr.ss_family = AF_INET6;
+                memcpy(&reinterpret_cast<sockaddr_in6*>(&addr)->sin6_addr, data + pos, 16);
+                v_addr.push_back(addr);
+            }
+            if (recordTTL < ttl)
+                ttl = recordTTL;
+        }
+        else if (record >= answers && type == DNS_TYPE_SOA && length >= 22)
+        { // RFC 2308:    min(TTL SOA,  MINIMUM) -  4  
+            unsigned minimum = Read32(data + pos + length - 4);
+            negative = recordTTL < minimum ? recordTTL : minimum;
+        }
+        pos += length;
+    }
+
+    if (v_addr.empty())
+        Finish(id, -1, v_addr, negative < maxTTL ? negative : maxTTL);
+    else
+        Finish(id, 0, v_addr, ttl);
+}
+
+/// <summary>
+///   :       
+/// </summary>
+/// <param name="id"> - ID    DNS </param>
+/// <param name="status"> -    (. ABSdnsHandler::OnResolve) </param>
+/// <param name="v_addr"> -   </param>
+/// <param name="ttl"> -      , 0 -   </param>
+void network::dnsResolver_t::Finish(unsigned short id, int status, const std::vector<sockaddr_storage>& v_addr, unsigned ttl)
+{
+    std::map<unsigned short, query_t>::iterator pending = m_pending.find(id);
+    if (pending == m_pending.end())
+        return;
+    //     :      Resolve
+    query_t query = std::move(pending->second);
+    m_pending.erase(pending);
+    m_inflight.erase(query.key);
+
+    //      :         
+    cacheEntry_t local;
+    local.v_addr = v_addr;
+    local.next = 0;
+    if (ttl != 0)
+    {
+        std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+        if (m_cache.size() >= CACHE_MAX)
+        { //  ,     -  
+            for (std::unordered_map<std::string, cacheEntry_t>::iterator iter = m_cache.begin(); iter != m_cache.end();)
+                if (iter->second.expires <= now)
+                    iter = m_cache.erase(iter);
+                else
+                    ++iter;
+            if (m_cache.size() >= CACHE_MAX)
+                m_cache.erase(m_cache.begin());
+        }
+        //       ,     
+        cacheEntry_t& entry = m_cache[query.key];
+        entry.v_addr = v_addr;
+        entry.next = v_addr.empty() ? 0 : query.v_waiters.size() % v_addr.size();
+        entry.expires = now + std::chrono::seconds(ttl);
+    }
+
+    for (size_t index = 0; index < query.v_waiters.size(); ++index)
+    {
+        const waiter_t& waiter = query.v_waiters[index];
+        if (status == 0)
+            Take(local, waiter.port, result);
+        else
+            result.ResetSockInfo();
+        waiter.handler->OnResolve(waiter.reqID, status, result);
+    }
+}
+
+/// <summary>
+///       
+/// </summary>
+void network::dnsResolver_t::CheckTimeouts()
+{
+    std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+    std::vector<unsigned short> v_failed;
+
+    for (std::map<unsigned short, query_t>::iterator iter = m_pending.begin(); iter != m_pending.end(); ++iter)
+        if (iter->second.deadline <= now)
+        {
+            if (iter->second.attempts >= attempts || !Send(iter->second))
+                v_failed.push_back(iter->first);
+        }
+
+    for (size_t index = 0; index < v_failed.size(); ++index)
+    {
+        logger.doLog("dnsResolver_t - no answer: " + m_pending[v_failed[index]].key.substr(1));
+        Finish(v_failed[index], -2, std::vector<sockaddr_storage>(), 0);
+    }
+}
+
+/// <summary>
+///        
+/// </summary>
+/// <param name="entry"> -     </param>
+/// <param name="port"> -  </param>
+/// <param name="addr"> -   </param>
+void network::dnsResolver_t::Take(cacheEntry_t& entry, unsigned short port, sockInfo_t& addr)
+{
+    sockaddr_storage* p_addr = reinterpret_cast<sockaddr_storage*>(addr.setSockAddr());
+    *p_addr = entry.v_addr[entry.next];
+    entry.next = (entry.next + 1) % entry.v_addr.size();
+
+    if (p_addr->ss_family == AF_INET)
+        reinterpret_cast<sockaddr_in*>(p_addr)->sin_port = htons(port);
+    else
+        reinterpret_cast<sockaddr_in6*>(p_addr)->sin6_port = htons(port);
+    addr.UpdateSockInfo(); //   setSockAddr()
+}
+
+/// <summary>
+///     
+/// </summary>
+/// <param name="timeOut"> -       </param>
+/// <param name="attempts"> -   (  1) </param>
+void network::dnsResolver_t::SetTimeout(unsigned timeOut, unsigned attempts)
+{
+    this->timeOut = timeOut;
+    this->attempts = attempts ? attempts : 1;
+}
+
+/// <summary>
+///      
+/// </summary>
+/// <param name="negativeTTL"> -     SOA   </param>
+/// <param name="maxTTL"> -        </param>
+void network::dnsResolver_t::SetTTL(unsigned negativeTTL, unsigned maxTTL)
+{
+    this->negativeTTL = negativeTTL;
+    this->maxTTL = maxTTL;
+}
+
+/// <summary>
+///   
+/// </summary>
+void network::dnsResolver_t::ClearCache()
+{
+    m_cache.clear();
+}
+
+/// <summary>
+///      ( ,   )
+/// </summary>
+/// <returns>   </returns>
+size_t network::dnsResolver_t::GetCacheSize() const
+{
+    return m_cache.size();
+}
+
+/// <summary>
+///    ,   
+/// </summary>
+/// <returns>   </returns>
+size_t network::dnsResolver_t::GetPendingCount() const
+{
+    return m_pending.size();
+}
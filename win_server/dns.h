@@ -0,0 +1,246 @@
+#pragma once
+#ifndef DNS_H_
+#define DNS_H_
+
+#include <string>
+#include <vector>
+#include <map>
+#include <unordered_map>
+#include <chrono>
+#include <random>
+
+#include "network.h"
+
+namespace network
+{
+    /// <summary>
+    ///     dnsResolver_t.    ,   Work(),
+    ///    (,  )   
+    /// </summary>
+    class ABSdnsHandler
+    {
+    public:
+        /// <summary>
+        ///     
+        /// </summary>
+        /// <param name="reqID"> - ID ,  Resolve </param>
+        /// <param name="status"> - 0 -  ;
+        ///                         -1 -          ;
+        ///                         -2 -      ;
+        ///                         -3 -       </param>
+        /// <param name="addr"> -      ( status != 0  ) </param>
+        virtual void OnResolve(int reqID, int status, const sockInfo_t& addr) = 0;
+
+        virtual ~ABSdnsHandler() {}
+    };
+
+    /// <summary>
+    ///   DNS   UDP_socket_t  .    :   
+    ///  ,         Work().   
+    ///  TTL ,  -  TTL  SOA (RFC 2308).       .
+    ///  : Resolve  Work     (,      )
+    /// </summary>
+    class dnsResolver_t : private RAII_OSsock
+    {
+    protected:
+        /// <summary>
+        ///   
+        /// </summary>
+        struct waiter_t
+        {
+            ABSdnsHandler* handler; // 
+            int reqID; // ID 
+            unsigned short port; //    
+        };
+
+        /// <summary>
+        ///   
+        /// </summary>
+        struct query_t
+        {
+            std::string key; //   (   )
+            std::string packet; //  ,   
+            std::chrono::steady_clock::time_point deadline; //      
+            unsigned attempts; //  
+            std::vector<waiter_t> v_waiters; //   
+        };
+
+        /// <summary>
+        ///  
+        /// </summary>
+        struct cacheEntry_t
+        {
+            std::vector<sockaddr_storage> v_addr; //  ,  -  
+            std::chrono::steady_clock::time_point expires; //    
+            size_t next; //     
+        };
+
+        /// <summary>
+        ///    (   )
+        /// </summary>
+        /// <param name="query"> -  </param>
+        /// <returns> 1 -    </returns>
+        bool Send(query_t& query);
+
+        /// <summary>
+        ///    
+        /// </summary>
+        /// <param name="data"> -   </param>
+        /// <param name="size"> -   </param>
+        void Answer(const unsigned char* data, size_t size);
+
+        /// <summary>
+        ///   :       
+        /// </summary>
+        /// <param name="id"> - ID    DNS </param>
+        /// <param name="status"> -    (. ABSdnsHandler::OnResolve) </param>
+        /// <param name="v_addr"> -   </param>
+        /// <param name="ttl"> -      , 0 -   </param>
+        void Finish(unsigned short id, int status, const std::vector<sockaddr_storage>& v_addr, unsigned ttl);
+
+        /// <summary>
+        ///       
+        /// </summary>
+        void CheckTimeouts();
+
+        /// <summary>
+        ///        
+        /// </summary>
+        /// <param name="entry"> -     </param>
+        /// <param name="port"> -  </param>
+        /// <param name="addr"> -   </param>
+        static void Take(cacheEntry_t& entry, unsigned short port, sockInfo_t& addr);
+
+        /// <summary>
+        ///      DNS (  )
+        /// </summary>
+        /// <param name="data"> -  </param>
+        /// <param name="size"> -   </param>
+        /// <param name="pos"> -  ,   -    </param>
+        /// <returns> 1 -   </returns>
+        static bool SkipName(const unsigned char* data, size_t size, size_t& pos);
+
+        /// <summary>
+        ///       :    ID    
+        /// ,   
+        /// </summary>
+        /// <returns> 1 -   </returns>
+        bool BindRandomPort();
+
+        /// <summary>
+        ///      :  ,   
+        /// </summary>
+        /// <param name="name"> -   </param>
+        /// <returns> 1 -   ( 1..63 ,   253) </returns>
+        static bool Normalize(std::string& name);
+
+    public:
+        /// <summary>
+        /// 
+        /// </summary>
+        /// <param name="server"> -   DNS (,  ) </param>
+        /// <param name="logger"> -   </param>
+        dnsResolver_t(const sockInfo_t& server, log_t& logger);
+
+        /// <summary>
+        /// 
+        /// </summary>
+        /// <param name="ip_server"> - IP   DNS   "..."  IPv6 </param>
+        /// <param name="port_server"> -  ,  53 </param>
+        /// <param name="logger"> -   </param>
+        dnsResolver_t(std::string ip_server, unsigned short port_server, log_t& logger);
+
+        //  -      
+        dnsResolver_t(const dnsResolver_t& resolver) = delete;
+        dnsResolver_t& operator = (const dnsResolver_t& resolver) = delete;
+
+        virtual ~dnsResolver_t();
+
+        /// <summary>
+        ///   .  IP      ,     
+        /// ( ,  ,   ),      Work()
+        /// </summary>
+        /// <param name="name"> -    IP </param>
+        /// <param name="port"> - ,       </param>
+        /// <param name="addr"> -     0 </param>
+        /// <param name="handler"> -     N>0,      </param>
+        /// <param name="af"> -  : AF_INET -  A, AF_INET6 -  AAAA </param>
+        /// <returns> 0 -    addr;
+        ///           N>0 - ID ,    handler.OnResolve;
+        ///           -1 -    (   );
+        ///           -2 -       </returns>
+        int Resolve(const std::string& name, unsigned short port, sockInfo_t& addr, ABSdnsHandler& handler, int af = AF_INET);
+
+        /// <summary>
+        ///  :  ,     
+        /// </summary>
+        /// <param name="timeOut"> -     , 0 -   (     ) </param>
+        /// <returns> 1 -       </returns>
+        bool Work(const int timeOut);
+
+        /// <summary>
+        ///       ,   :    
+        /// </summary>
+        /// <param name="timeOut"> -     , -1 -  </param>
+        /// <returns>     </returns>
+        int GetWait(const int timeOut) const;
+
+        /// <summary>
+        ///     -           
+        /// (   GetWait)  Work(0)
+        /// </summary>
+        /// <returns>   </returns>
+        std::shared_ptr<socket_t> GetSocket() const;
+
+        /// <summary>
+        ///     
+        /// </summary>
+        /// <param name="timeOut"> -       </param>
+        /// <param name="attempts"> -   (  1) </param>
+        void SetTimeout(unsigned timeOut, unsigned attempts);
+
+        /// <summary>
+        ///      
+        /// </summary>
+        /// <param name="negativeTTL"> -     SOA   </param>
+        /// <param name="maxTTL"> -        </param>
+        void SetTTL(unsigned negativeTTL, unsigned maxTTL);
+
+        /// <summary>
+        ///   
+        /// </summary>
+        void ClearCache();
+
+        /// <summary>
+        ///      ( ,   )
+        /// </summary>
+        /// <returns>   </returns>
+        size_t GetCacheSize() const;
+
+        /// <summary>
+        ///    ,   
+        /// </summary>
+        /// <returns>   </returns>
+        size_t GetPendingCount() const;
+
+        static const size_t CACHE_MAX = 4096; //    
+    protected:
+        sockInfo_t server; //   DNS
+        std::shared_ptr<UDP_socket_t> socket; //  
+        NonBlockSocket_manager_t manager; //  
+        std::map<unsigned short, query_t> m_pending; //   ,  - ID   DNS
+        std::unordered_map<std::string, unsigned short> m_inflight; //   - ID   
+        std::unordered_map<std::string, cacheEntry_t> m_cache; //  ,  -    
+        std::mt19937 random; //  ID    ( ID     )
+        std::string s_key; //  ,   
+        sockInfo_t result; //    ,   
+        unsigned timeOut; //      
+        unsigned attempts; //  
+        unsigned negativeTTL; //     SOA  
+        unsigned maxTTL; //      
+        int lastReqID; //   ID  
+        log_t& logger; //  
+    };
+};
+
+#endif /* DNS_H_ */
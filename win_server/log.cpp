@@ -1,13 +1,35 @@
 #include "log.h"
 #include <chrono>
-#include <sstream>
-#include <iomanip>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+
+#ifdef __WIN32__
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif // !WIN32_LEAN_AND_MEAN
+#include <Windows.h>
+#endif
+
+static std::atomic<unsigned long long> logInstanceCounter(0); //     
+
+/// <summary>
+///        
+/// </summary>
+static size_t RoundUpPow2(size_t size)
+{
+    size_t result = 2;
+    while (result < size)
+        result <<= 1;
+    return result;
+}
 
 /// <summary>
 ///   
 ///      ,    
 /// </summary>
-log_t::log_t() : consoleActive(true), lastErr(0)
+log_t::log_t() : consoleActive(true), lastErr(0), timeStamp(false), async(false), policy(policy_t::BLOCK), ringSize(0), instanceID(++logInstanceCounter), dropped(0), b_stop(false),
+    blocked(0)
 {
     time_zone = 3; // TO_DO
 }
@@ -16,7 +38,8 @@ log_t::log_t() : consoleActive(true), lastErr(0)
 /// </summary>
 /// <param name="nameLogFile"> -    </param>
 /// <param name="consoleActive"> -      </param>
-log_t::log_t(std::string nameLogFile, bool consoleActive) : consoleActive(consoleActive), lastErr(0)
+log_t::log_t(std::string nameLogFile, bool consoleActive) : consoleActive(consoleActive), lastErr(0), timeStamp(false), async(false), policy(policy_t::BLOCK), ringSize(0),
+    instanceID(++logInstanceCounter), dropped(0), b_stop(false), blocked(0)
 {
     time_zone = 3; // TO_DO
     logFile.open(nameLogFile.c_str(), std::ios::app); //     
@@ -26,13 +49,260 @@ log_t::log_t(std::string nameLogFile, bool consoleActive) : consoleActive(consol
         else std::cerr << "logFile.open fail";//TODO check
     }
 }
+/// <summary>
+///   
+/// </summary>
+/// <param name="nameLogFile"> -    </param>
+/// <param name="consoleActive"> -      </param>
+/// <param name="policy"> -      (policy_t) </param>
+/// <param name="ringSize"> -      ,     </param>
+log_t::log_t(std::string nameLogFile, bool consoleActive, int policy, size_t ringSize) : consoleActive(consoleActive), lastErr(0), timeStamp(false), async(true), policy(policy),
+    ringSize(ringSize < 256 ? 256 : ringSize), instanceID(++logInstanceCounter), dropped(0), b_stop(false), blocked(0)
+{
+    time_zone = 3; // TO_DO
+    logFile.open(nameLogFile.c_str(), std::ios::app); //     
+    if (!logFile)
+    {
+        if (consoleActive) std::cout << "logFile.open fail";
+        else std::cerr << "logFile.open fail";
+    }
+    writer = std::thread([this]() { WriterWork(); });
+}
 
 log_t::~log_t()
 {
+    if (writer.joinable())
+    { //       
+        b_stop = true;
+        mtx_writer.lock();
+        cv_writer.notify_one();
+        cv_space.notify_all();
+        mtx_writer.unlock();
+        writer.join();
+    }
     if (logFile.is_open()) //    - 
         logFile.close();
 }
 /// <summary>
+///   
+/// </summary>
+/// <param name="capacity"> - ,      </param>
+log_t::ring_t::ring_t(size_t capacity) : MASK(RoundUpPow2(capacity) - 1), p_data(new char[MASK + 1]), head(0), tail(0), closed(false)
+{}
+/// <summary>
+///     (    )   ( )
+/// </summary>
+/// <param name="msg"> -   </param>
+void log_t::Write(std::string& msg)
+{
+    std::shared_ptr<ring_t> ring = GetRing();
+    if (msg.size() > ring->MASK + 1 && policy != policy_t::GROW)
+    { //        - 
+        msg.resize(ring->MASK);
+        msg.push_back('\n');
+    }
+
+    while (!Push(*ring, msg.data(), msg.size()))
+    {
+        if (policy == policy_t::DROP)
+        {
+            dropped.fetch_add(1, std::memory_order_relaxed);
+            break;
+        }
+        else if (policy == policy_t::GROW)
+        { //     ,    
+            size_t capacity = (ring->MASK + 1) * 2;
+            while (capacity < msg.size())
+                capacity *= 2;
+            ring = GrowRing(capacity);
+        }
+        else if (!WaitSpace(*ring, msg.size())) // BLOCK - ,      
+            break; //  
+    }
+}
+/// <summary>
+///       (policy_t::BLOCK)
+/// </summary>
+/// <param name="ring"> -  </param>
+/// <param name="size"> -   </param>
+/// <returns> 1 -  ; 0 -  ,     </returns>
+bool log_t::WaitSpace(ring_t& ring, size_t size)
+{
+    std::unique_lock<std::mutex> lock(mtx_writer);
+    blocked.fetch_add(1);
+    cv_writer.notify_one();
+    //       ;         
+    while (!b_stop.load() && size > ring.MASK + 1 - (ring.head.load(std::memory_order_relaxed) - ring.tail.load(std::memory_order_acquire)))
+        cv_space.wait_for(lock, std::chrono::milliseconds(10));
+    blocked.fetch_sub(1);
+    return !b_stop.load();
+}
+/// <summary>
+///   :  ,       
+/// </summary>
+log_t::ringCache_t::~ringCache_t()
+{
+    for (size_t index = 0; index < v_ring.size(); ++index)
+        if (v_ring[index].second != nullptr)
+            v_ring[index].second->closed.store(true, std::memory_order_release);
+}
+/// <summary>
+///     ,       
+/// </summary>
+/// <returns>      (,     ) </returns>
+std::shared_ptr<log_t::ring_t>& log_t::CachedRing()
+{
+    static thread_local ringCache_t cache;
+
+    for (size_t index = 0; index < cache.v_ring.size(); ++index)
+        if (cache.v_ring[index].first == instanceID)
+            return cache.v_ring[index].second;
+
+    cache.v_ring.push_back(std::make_pair(instanceID, std::shared_ptr<ring_t>()));
+    return cache.v_ring.back().second;
+}
+/// <summary>
+///     ,      
+/// </summary>
+/// <returns>   </returns>
+std::shared_ptr<log_t::ring_t> log_t::GetRing()
+{
+    std::shared_ptr<ring_t>& ring = CachedRing();
+    if (ring == nullptr)
+        ring = AddRing(ringSize);
+    return ring;
+}
+/// <summary>
+///       (policy_t::GROW)
+/// </summary>
+/// <param name="capacity"> -    </param>
+/// <returns>    </returns>
+std::shared_ptr<log_t::ring_t> log_t::GrowRing(size_t capacity)
+{
+    std::shared_ptr<ring_t>& ring = CachedRing();
+    ring->closed.store(true, std::memory_order_release); //     ,      
+    ring = AddRing(capacity);
+    return ring;
+}
+/// <summary>
+///        
+/// </summary>
+/// <param name="capacity"> -   </param>
+/// <returns>   </returns>
+std::shared_ptr<log_t::ring_t> log_t::AddRing(size_t capacity)
+{
+    std::shared_ptr<ring_t> ring = std::make_shared<ring_t>(capacity);
+    std::lock_guard<std::mutex> lock(mtx_ring);
+    v_ring.push_back(ring);
+    return ring;
+}
+/// <summary>
+///      ( -)
+/// </summary>
+/// <param name="ring"> -  </param>
+/// <param name="data"> -  </param>
+/// <param name="size"> -   </param>
+/// <returns> 1 - ; 0 -   </returns>
+bool log_t::Push(ring_t& ring, const char* data, size_t size)
+{
+    size_t head = ring.head.load(std::memory_order_relaxed);
+    size_t tail = ring.tail.load(std::memory_order_acquire);
+    if (size > ring.MASK + 1 - (head - tail))
+        return false;
+
+    size_t pos = head & ring.MASK;
+    size_t first = ring.MASK + 1 - pos; //   
+    if (first > size)
+        first = size;
+    memcpy(&ring.p_data[pos], data, first);
+    memcpy(&ring.p_data[0], data + first, size - first);
+    ring.head.store(head + size, std::memory_order_release); //     
+    return true;
+}
+/// <summary>
+///    (  )
+/// </summary>
+/// <param name="ring"> -  </param>
+/// <param name="out"> - ,     </param>
+void log_t::Drain(ring_t& ring, std::string& out)
+{
+    size_t tail = ring.tail.load(std::memory_order_relaxed);
+    size_t head = ring.head.load(std::memory_order_acquire);
+    size_t size = head - tail;
+    if (size == 0)
+        return;
+
+    size_t pos = tail & ring.MASK;
+    size_t first = ring.MASK + 1 - pos; //   
+    if (first > size)
+        first = size;
+    out.append(&ring.p_data[pos], first);
+    out.append(&ring.p_data[0], size - first);
+    ring.tail.store(head, std::memory_order_release); //   
+}
+/// <summary>
+///    :        
+/// </summary>
+void log_t::WriterWork()
+{
+    std::string batch; //   
+    std::vector<std::shared_ptr<ring_t>> v_snapshot; //   ,       
+
+    for (;;)
+    {
+        bool stop = b_stop.load();
+        {
+            std::lock_guard<std::mutex> lock(mtx_ring);
+            v_snapshot = v_ring;
+        }
+
+        batch.clear();
+        for (size_t index = 0; index < v_snapshot.size(); ++index)
+        {
+            bool closed = v_snapshot[index]->closed.load(std::memory_order_acquire); //  :      
+            Drain(*v_snapshot[index], batch);
+            if (closed)
+            {
+                std::lock_guard<std::mutex> lock(mtx_ring);
+                for (size_t pos = 0; pos < v_ring.size(); ++pos)
+                    if (v_ring[pos] == v_snapshot[index])
+                    {
+                        v_ring.erase(v_ring.begin() + pos);
+                        break;
+                    }
+            }
+        }
+        v_snapshot.clear();
+        if (blocked.load() != 0)
+        { //   -  ,   (policy_t::BLOCK)
+            std::lock_guard<std::mutex> lock(mtx_writer);
+            cv_space.notify_all();
+        }
+
+        unsigned long long lost = dropped.exchange(0, std::memory_order_relaxed);
+        if (lost != 0)
+            batch.append("log_t - dropped records: " + std::to_string(lost) + '\n');
+
+        if (!batch.empty())
+        { //     
+            if (consoleActive) fwrite(batch.data(), 1, batch.size(), stdout);
+            if (logFile.is_open())
+            {
+                logFile.write(batch.data(), batch.size());
+                logFile.flush();
+            }
+        }
+        else if (stop) //     
+            break;
+        else
+        { //   - ;       ,   
+            std::unique_lock<std::mutex> lock(mtx_writer);
+            if (!b_stop.load() && blocked.load() == 0) //    -       
+                cv_writer.wait_for(lock, std::chrono::milliseconds(10));
+        }
+    }
+}
+/// <summary>
 ///     
 /// </summary>
 /// <param name="log"> -   </param>
@@ -40,8 +310,13 @@ log_t::~log_t()
 void log_t::doLog(std::string log, int errCode)
 {
     //    
-    std::string msg /*= getTime()*/;
-    /*msg.append(" :: "); */
+    std::string msg;
+    if (timeStamp)
+    { //     ,   
+        msg.resize(TIME_SIZE);
+        FormatTime(&msg[0]);
+        msg.append(" :: ");
+    }
     msg.append(log);
     //    ,  
     if (errCode != 0x80000000)
@@ -50,6 +325,12 @@ void log_t::doLog(std::string log, int errCode)
         msg.append(" errno: ");
         msg.append(std::to_string(errCode));
     }
+    if (async)
+    { //      
+        msg.push_back('\n');
+        Write(msg);
+        return;
+    }
     //   
     if (consoleActive) printf("%s\n", msg.c_str());
     //   
@@ -66,6 +347,12 @@ void log_t::doDebugTrace(std::string trace)
     std::string msg = getTime();
     msg.append(" :: ");
     msg.append(trace);
+    if (async)
+    { //      
+        trace.push_back('\n');
+        Write(trace);
+        return;
+    }
     //   
     if (consoleActive) std::cout << trace << '\n';
     //   
@@ -81,99 +368,122 @@ int log_t::GetLastErr() const
     return lastErr;
 }
 /// <summary>
-///   
+///    
 /// </summary>
-/// <returns>   "..->::"</returns>
-std::string log_t::getTime()
+/// <returns> 1 -  , doLog         </returns>
+bool log_t::IsAsync() const
 {
-    // ++17 
-    std::stringstream result; // 
-
-    bool leap = false; //   
-
-    auto now = std::chrono::system_clock::now().time_since_epoch();// 1970 
-    auto msec = std::chrono::duration_cast<std::chrono::milliseconds> (now); // 
-    auto sec = std::chrono::duration_cast<std::chrono::seconds> (now); // 
-    auto min = std::chrono::duration_cast<std::chrono::minutes> (now); // 
-    auto tempHour = std::chrono::duration_cast<std::chrono::hours> (now); // 
-    //  ++17   ,   (   ++20) 
-    int hour = tempHour.count() + time_zone; // +3    
-
-    int totalDay = hour / 24; //   
-    std::string weekDays; //  
-
-    switch ((totalDay + 3) % 7) //    1970 
+    return async;
+}
+/// <summary>
+///      01.01.1970   ( ,   )
+/// </summary>
+/// <param name="days"> -   </param>
+/// <param name="year"> -  </param>
+/// <param name="month"> -  1..12 </param>
+/// <param name="day"> -  1..31 </param>
+static void CivilFromDays(long long days, long long& year, unsigned& month, unsigned& day)
+{
+    days += 719468; //   01.03.0000 -     
+    long long era = (days >= 0 ? days : days - 146096) / 146097; // 400- 
+    unsigned doe = unsigned(days - era * 146097); //   [0, 146096]
+    unsigned yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365; //   [0, 399]
+    unsigned doy = doe - (365 * yoe + yoe / 4 - yoe / 100); //     [0, 365]
+    unsigned mp = (5 * doy + 2) / 153; //    [0, 11]
+    day = doy - (153 * mp + 2) / 5 + 1;
+    month = mp < 10 ? mp + 3 : mp - 9;
+    year = (long long)yoe + era * 400 + (month <= 2);
+}
+/// <summary>
+///    
+/// </summary>
+static inline void PutTwoDigits(char* buffer, unsigned value)
+{
+    buffer[0] = char('0' + value / 10);
+    buffer[1] = char('0' + value % 10);
+}
+/// <summary>
+///        01.01.1970   ()  ,  -  
+/// </summary>
+/// <returns>    </returns>
+long long log_t::CoarseTimeMs()
+{
+#ifdef __WIN32__
+    FILETIME time; //   100   01.01.1601
+    GetSystemTimeAsFileTime(&time);
+    unsigned long long ticks = ((unsigned long long)time.dwHighDateTime << 32) | time.dwLowDateTime;
+    return (long long)((ticks - 116444736000000000ULL) / 10000);
+#elif defined(CLOCK_REALTIME_COARSE)
+    timespec time;
+    clock_gettime(CLOCK_REALTIME_COARSE, &time);
+    return (long long)time.tv_sec * 1000 + time.tv_nsec / 1000000;
+#else
+    return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+#endif
+}
+/// <summary>
+///        . ,        
+///     ,        
+/// </summary>
+/// <param name="buffer"> -    TIME_SIZE ,     </param>
+/// <returns>    (TIME_SIZE) </returns>
+size_t log_t::FormatTime(char* buffer)
+{
+    struct cache_t //    
     {
-    case 0:
-        weekDays = "monday";
-        break;
-    case 1:
-        weekDays = "tuesday";
-        break;
-    case 2:
-        weekDays = "wednesday";
-        break;
-    case 3:
-        weekDays = "thursday";
-        break;
-    case 4:
-        weekDays = "friday";
-        break;
-    case 5:
-        weekDays = "saturday";
-        break;
-    case 6:
-        weekDays = "sunday";
-        break;
-    default:
-        break;
-    }
+        cache_t() : minute(-1)
+        {}
+        long long minute; //   (   ),    
+        char prefix[PREFIX_SIZE]; // "[-- ::"
+    };
+    static thread_local cache_t cache;
 
-    int year = 1969; //   
-    int day = 0; // 
-
-    while (totalDay > 0) //      
-    {
-        ++year; //  
-        leap = year % 4 == 0; //   ?
-        day = totalDay; //   
-        totalDay -= leap ? 366 : 365; //       
+    long long msec = CoarseTimeMs() + (long long)time_zone * 3600000;
+    long long minute = msec / 60000;
+    if (minute != cache.minute)
+    { //   -  
+        long long year;
+        unsigned month, day;
+        CivilFromDays(minute / 1440, year, month, day);
+        cache.prefix[0] = '[';
+        PutTwoDigits(&cache.prefix[1], unsigned(year / 100 % 100));
+        PutTwoDigits(&cache.prefix[3], unsigned(year % 100));
+        cache.prefix[5] = '-';
+        PutTwoDigits(&cache.prefix[6], month);
+        cache.prefix[8] = '-';
+        PutTwoDigits(&cache.prefix[9], day);
+        cache.prefix[11] = ' ';
+        PutTwoDigits(&cache.prefix[12], unsigned(minute / 60 % 24));
+        cache.prefix[14] = ':';
+        PutTwoDigits(&cache.prefix[15], unsigned(minute % 60));
+        cache.prefix[17] = ':';
+        cache.minute = minute;
     }
 
-    int mounth = 0; //           
-    if (day < 31) mounth = 1;
-    else if (leap ? day < 59 : day < 60) { mounth = 2; day -= 31; }
-    else if (leap ? day < 90 : day < 91) { mounth = 3; day -= leap ? 59 : 60; }
-    else if (leap ? day < 120 : day < 121) { mounth = 4; day -= leap ? 90 : 91; }
-    else if (leap ? day < 151 : day < 152) { mounth = 5; day -= leap ? 120 : 121; }
-    else if (leap ? day < 181 : day < 182) { mounth = 6; day -= leap ? 151 : 152; }
-    else if (leap ? day < 212 : day < 213) { mounth = 7; day -= leap ? 181 : 182; }
-    else if (leap ? day < 243 : day < 244) { mounth = 8; day -= leap ? 212 : 213; }
-    else if (leap ? day < 273 : day < 274) { mounth = 9; day -= leap ? 243 : 244; }
-    else if (leap ? day < 304 : day < 305) { mounth = 10; day -= leap ? 273 : 274; }
-    else if (leap ? day < 334 : day < 335) { mounth = 11; day -= leap ? 304 : 305; }
-    else if (leap ? day < 365 : day < 366) { mounth = 12; day -= leap ? 334 : 335; }
-    //    "..- -:::"
-    /*result << std::setfill('0') << year << '.' << std::setw(2) << mounth << '.' << std::setw(2) << day << '-' << weekDays << '-' //
-        << std::setw(2) << hour % 24 << ':' << std::setw(2) << min.count() % 60 << ':' << std::setw(2) << sec.count() % 60 //
-        << '.' << std::setw(3) << msec.count() % 1000;//
-
-     return std::string(result.str());*/
-
-    
-    //       "PBF group"   
-    result << '[' << std::setfill('0') << year << '-' << std::setw(2) << mounth << '-' << std::setw(2) << day << /*'-' << weekDays << '-'*/' ' //
-        << std::setw(2) << hour % 24 << ':' << std::setw(2) << min.count() % 60 << ':' << std::setw(2) << sec.count() % 60 //
-        << '.' << std::setw(3) << msec.count() % 1000 << ']';//
-
-    return std::string(result.str());
-
-    // ++03 -  (,  )
-    /*char result[64]; // 
-    std::memset(&result, 0, sizeof(result));
-    time_t t1 = time(NULL);//     time_t   ,   00:00 1  1970.
-    tm t = *localtime(&t1);// localtime()   time_t   tm,    ,   , , ,   . .
-    std::sprintf(result ,"%.4d.%.2d.%.2d.->%.2d:%.2d:%.2d", t.tm_year + 1900, t.tm_mon, t.tm_mday, t.tm_hour, t.tm_min, t.tm_sec);
-    return std::string(result);*/
-}
+    memcpy(buffer, cache.prefix, PREFIX_SIZE);
+    unsigned rest = unsigned(msec % 60000); //   
+    PutTwoDigits(&buffer[PREFIX_SIZE], rest / 1000);
+    buffer[PREFIX_SIZE + 2] = '.';
+    buffer[PREFIX_SIZE + 3] = char('0' + rest / 100 % 10);
+    PutTwoDigits(&buffer[PREFIX_SIZE + 4], rest % 100);
+    buffer[PREFIX_SIZE + 6] = ']';
 
+    return TIME_SIZE;
+}
+/// <summary>
+///   
+/// </summary>
+/// <returns>   "[-- ::.]"</returns>
+std::string log_t::getTime()
+{
+    char buffer[TIME_SIZE];
+    return std::string(buffer, FormatTime(buffer));
+}
+/// <summary>
+///         doLog
+/// </summary>
+/// <param name="enable"> - 1 -   </param>
+void log_t::EnableTimeStamp(bool enable)
+{
+    timeStamp = enable;
+}
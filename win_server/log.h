@@ -5,6 +5,12 @@
 #include <iostream>
 #include <fstream>
 #include <string>
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <vector>
+#include <memory>
 
 #ifdef DEBUG
 #define DEBUG_TRACE(logger, string) logger.doDebugTrace(string)
@@ -13,25 +19,98 @@
 #endif
 
 /// <summary>
-///       / 
+///       / .
+///    doLog         ( ),
+///               
 /// </summary>
 class log_t
 {
 public:
+    struct policy_t //       
+    {
+        static const int BLOCK = 0; // ,     
+        static const int DROP = 1; //  ,     
+        static const int GROW = 2; //     
+    };
+
     log_t();
     log_t(std::string nameLogFile, bool consoleActive);
+    /// <summary>
+    ///   
+    /// </summary>
+    /// <param name="nameLogFile"> -    </param>
+    /// <param name="consoleActive"> -      </param>
+    /// <param name="policy"> -      (policy_t) </param>
+    /// <param name="ringSize"> -      ,     </param>
+    log_t(std::string nameLogFile, bool consoleActive, int policy, size_t ringSize = 1 << 16);
+    //  -      
+    log_t(const log_t& log) = delete;
+    log_t& operator = (const log_t& log) = delete;
+    static const size_t TIME_SIZE = 25; //    "[-- ::.]"
     std::string getTime();
+    size_t FormatTime(char* buffer);
+    void EnableTimeStamp(bool enable);
     void doLog(std::string log, int errCode = 0x80000000);
 #ifdef DEBUG
     void doDebugTrace(std::string trace);
 #endif
     int GetLastErr() const;
+    bool IsAsync() const;
     virtual ~log_t();
 protected:
+    /// <summary>
+    ///    :   -,    
+    /// </summary>
+    struct ring_t
+    {
+        ring_t(size_t capacity);
+        const size_t MASK; //   ( - 1)
+        std::unique_ptr<char[]> p_data; // 
+        std::atomic<size_t> head; //   ()
+        std::atomic<size_t> tail; //   ( )
+        std::atomic_bool closed; //     - ,   
+    };
+
+    /// <summary>
+    ///     :      ,     
+    /// </summary>
+    struct ringCache_t
+    {
+        ~ringCache_t();
+        std::vector<std::pair<unsigned long long, std::shared_ptr<ring_t>>> v_ring; //   - 
+    };
+
+    static const size_t PREFIX_SIZE = 18; //         "[-- ::"
+    static long long CoarseTimeMs();
+    void Write(std::string& msg);
+    std::shared_ptr<ring_t>& CachedRing();
+    std::shared_ptr<ring_t> GetRing();
+    std::shared_ptr<ring_t> GrowRing(size_t capacity);
+    std::shared_ptr<ring_t> AddRing(size_t capacity);
+    bool Push(ring_t& ring, const char* data, size_t size);
+    bool WaitSpace(ring_t& ring, size_t size);
+    static void Drain(ring_t& ring, std::string& out);
+    void WriterWork();
+
     std::ofstream logFile; //   
     bool consoleActive; //    
     int time_zone; //  
-    int lastErr; //   
+    std::atomic<int> lastErr; //   
+    std::atomic_bool timeStamp; //      doLog
+
+    const bool async; //  
+    const int policy; //     
+    const size_t ringSize; //    
+    const unsigned long long instanceID; //    (   )
+    std::vector<std::shared_ptr<ring_t>> v_ring; //    
+    std::mutex mtx_ring; //    (     )
+    std::atomic<unsigned long long> dropped; //    (policy_t::DROP)
+    std::atomic_bool b_stop; //    
+    std::condition_variable cv_writer; //   
+    std::condition_variable cv_space; //  ,     (policy_t::BLOCK)
+    std::atomic<int> blocked; //  ,  
+    std::mutex mtx_writer; //    
+    std::thread writer; //  
 };
 
 #endif // !LOG_T
@@ -0,0 +1,143 @@
+#pragma once
+#ifndef MPMCQUEUE_H_
+#define MPMCQUEUE_H_
+
+#include <atomic>
+#include <memory>
+#include <cstddef>
+
+/// <summary>
+///           ( ).
+///     :   ,      ,
+///  -       .    - O(1),  CAS  
+/// </summary>
+/// <typeparam name="T"> -  ,        </typeparam>
+template <typename T>
+class mpmcQueue_t
+{
+protected:
+    /// <summary>
+    ///  
+    /// </summary>
+    struct cell_t
+    {
+        std::atomic<size_t> sequence; //   
+        T data; // 
+    };
+
+    static const size_t CACHE_LINE = 64; //  -,        
+
+public:
+    /// <summary>
+    /// 
+    /// </summary>
+    /// <param name="capacity"> -  ,      </param>
+    explicit mpmcQueue_t(size_t capacity) : MASK(RoundUp(capacity) - 1), p_cells(new cell_t[MASK + 1]), enqueuePos(0), dequeuePos(0)
+    {
+        for (size_t index = 0; index <= MASK; ++index)
+            p_cells[index].sequence.store(index, std::memory_order_relaxed);
+    }
+
+    //  -    
+    mpmcQueue_t(const mpmcQueue_t& queue) = delete;
+    mpmcQueue_t& operator = (const mpmcQueue_t& queue) = delete;
+
+    /// <summary>
+    ///     
+    /// </summary>
+    /// <param name="value"> - ,     </param>
+    /// <returns> 1 -   ; 0 -   </returns>
+    bool TryPush(T& value)
+    {
+        size_t pos = enqueuePos.load(std::memory_order_relaxed);
+        for (;;)
+        {
+            cell_t& cell = p_cells[pos & MASK];
+            size_t sequence = cell.sequence.load(std::memory_order_acquire);
+            std::ptrdiff_t diff = std::ptrdiff_t(sequence) - std::ptrdiff_t(pos);
+            if (diff == 0)
+            { //   -   
+                if (enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                {
+                    cell.data = std::move(value);
+                    cell.sequence.store(pos + 1, std::memory_order_release); //   
+                    return true;
+                }
+            }
+            else if (diff < 0) //        -  
+                return false;
+            else //    ,  
+                pos = enqueuePos.load(std::memory_order_relaxed);
+        }
+    }
+
+    /// <summary>
+    ///     
+    /// </summary>
+    /// <param name="value"> -   </param>
+    /// <returns> 1 -  ; 0 -   </returns>
+    bool TryPop(T& value)
+    {
+        size_t pos = dequeuePos.load(std::memory_order_relaxed);
+        for (;;)
+        {
+            cell_t& cell = p_cells[pos & MASK];
+            size_t sequence = cell.sequence.load(std::memory_order_acquire);
+            std::ptrdiff_t diff = std::ptrdiff_t(sequence) - std::ptrdiff_t(pos + 1);
+            if (diff == 0)
+            { //   -   
+                if (dequeuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                {
+                    value = std::move(cell.data);
+                    cell.data = T(); //       
+                    cell.sequence.store(pos + MASK + 1, std::memory_order_release); //     
+                    return true;
+                }
+            }
+            else if (diff < 0) //      -  
+                return false;
+            else //    ,  
+                pos = dequeuePos.load(std::memory_order_relaxed);
+        }
+    }
+
+    /// <summary>
+    ///     ( ,   )
+    /// </summary>
+    /// <returns> 1 -      </returns>
+    bool Empty() const
+    {
+        return enqueuePos.load(std::memory_order_seq_cst) == dequeuePos.load(std::memory_order_seq_cst);
+    }
+
+    /// <summary>
+    ///    
+    /// </summary>
+    /// <returns>  </returns>
+    size_t Capacity() const
+    {
+        return MASK + 1;
+    }
+
+protected:
+    /// <summary>
+    ///      
+    /// </summary>
+    static size_t RoundUp(size_t capacity)
+    {
+        size_t result = 2;
+        while (result < capacity)
+            result <<= 1;
+        return result;
+    }
+
+    const size_t MASK; //    ( - 1)
+    std::unique_ptr<cell_t[]> p_cells; //  
+    char pad0[CACHE_LINE];
+    std::atomic<size_t> enqueuePos; //  
+    char pad1[CACHE_LINE - sizeof(std::atomic<size_t>)];
+    std::atomic<size_t> dequeuePos; //  
+    char pad2[CACHE_LINE - sizeof(std::atomic<size_t>)];
+};
+
+#endif /* MPMCQUEUE_H_ */
@@ -7,7 +7,10 @@ std::unordered_set<unsigned> g_journal; // 
 /// <summary>
 ///   
 /// </summary>
-network::RAII_OSsock::RAII_OSsock(log_t& logger) : journal(g_journal)
+network::RAII_OSsock::RAII_OSsock(log_t& logger)
+#ifdef __WIN32__
+    : journal(g_journal)
+#endif
 {
 #ifdef __WIN32__
     if (journal.empty()) //         = 0
@@ -16,6 +19,13 @@ network::RAII_OSsock::RAII_OSsock(log_t& logger) : journal(g_journal)
 
     objectID = ++countWSAusers; //   ID
     journal.insert(objectID); //  
+#else
+    // sendfile()  splice()   MSG_NOSIGNAL:        
+    //       SIGPIPE;  EPIPE     .
+    //     -    
+    static const bool ignorePipe = (signal(SIGPIPE, SIG_IGN) != SIG_ERR);
+    if (!ignorePipe)
+        logger.doLog("RAII_OSsock - signal(SIGPIPE) ", GetError());
 #endif
 }
 network::RAII_OSsock::~RAII_OSsock()
@@ -32,7 +42,7 @@ network::RAII_OSsock::~RAII_OSsock()
 ///     
 /// </summary>
 /// <returns>    </returns>
-int network::RAII_OSsock::GetError()
+int network::RAII_OSsock::GetError() const
 {
 #ifdef __WIN32__
     return WSAGetLastError();
@@ -57,7 +67,7 @@ bool network::RAII_OSsock::setSocketOpt(SOCKET sock, int option, log_t& logger)
     case option_t::NON_BLOCK: //     
     {
 #ifdef __WIN32__
-        u_long mode = 0;
+        u_long mode = 1; //     
         if (ioctlsocket(sock, FIONBIO, &mode))
             logger.doLog("RAII_OSsock - ioctlsocket ", GetError());//  
         else
@@ -68,6 +78,33 @@ bool network::RAII_OSsock::setSocketOpt(SOCKET sock, int option, log_t& logger)
         else
             result = true;
 #endif
+        break;
+    }
+    case option_t::REUSE_PORT: //        
+    {
+#if !defined(__WIN32__) && defined(SO_REUSEPORT)
+        int enable = 1;
+        if (setsockopt(sock, SOL_SOCKET, SO_REUSEPORT, &enable, sizeof(enable)))
+            logger.doLog("RAII_OSsock - setsockopt SO_REUSEPORT ", GetError());//  
+        else
+            result = true;
+#else //  Windows SO_REUSEADDR   ,      -  
+        logger.doLog("RAII_OSsock - SO_REUSEPORT not supported");
+#endif
+        break;
+    }
+    case option_t::DUAL_STACK: //    IPv4  IPv6 ( Windows   ,  Linux   bindv6only)
+    {
+#ifdef __WIN32__
+        DWORD v6only = 0;
+#else
+        int v6only = 0;
+#endif
+        if (setsockopt(sock, IPPROTO_IPV6, IPV6_V6ONLY, reinterpret_cast<const char*>(&v6only), sizeof(v6only)))
+            logger.doLog("RAII_OSsock - setsockopt IPV6_V6ONLY ", GetError());//  
+        else
+            result = true;
+        break;
     }
     default:
         break;
@@ -85,59 +122,64 @@ int network::RAII_OSsock::countWSAusers = 0;
 /// <summary>
 ///     .         UpdateSockInfo()
 /// </summary>
-/// <returns>      </returns>
+/// <returns>      ( sizeof(sockaddr_storage)) </returns>
 sockaddr* network::sockInfo_t::setSockAddr()
 {
-    return &Addr;
+    return reinterpret_cast<sockaddr*>(&Addr);
 }
 
 /// <summary>
 ///     ,    Addr  setSockAddr()
 /// </summary>
 void network::sockInfo_t::UpdateSockInfo()
-{
-    //      
-    IP_port.first.clear();
-    IP_port.second = 0;
-
-    sockaddr_in AddrIN; //        IP
-    memset(&AddrIN, 0, SizeAddr());
-    memmove(&AddrIN, &Addr, SizeAddr()); //Addr ==>> AddrIN
-
-    char bufIP[32];//    IP
-    memset(bufIP, '\0', sizeof(bufIP));
+{ //  IP     GetIP(),     -   
+    b_IPvalid = false;
+}
 
-    //  InetNtop  - IPv4  IPv6      
-    if (inet_ntop(AF_INET, &AddrIN, bufIP, sizeof(bufIP)))
-    {
-        IP_port.first.assign(bufIP);
-        IP_port.second = ntohs(AddrIN.sin_port);
-    }
-    else //  
-        logger.doLog("inet_ntop fail", GetError());
+/// <summary>
+///      (  )
+/// </summary>
+void network::sockInfo_t::ResetSockInfo()
+{
+    memset(&Addr, 0, sizeof(Addr));
+    Addr.ss_family = AF_UNSPEC;
+    b_IPvalid = false;
 }
 
 /// <summary>
-///     ,    Addr
+///      :  IPv4   IPv6   ::ffff:a.b.c.d
 /// </summary>
-/// <param name="ip"> IP    "..." </param>
-/// <param name="port">   </param>
-void network::sockInfo_t::UpdateSockInfo(std::string ip, unsigned short port)
+/// <param name="addr"> -  ,    </param>
+/// <param name="af"> -    </param>
+/// <returns>      </returns>
+socklen_t network::sockInfo_t::MapAddr(sockaddr_storage& addr, int af)
 {
-    IP_port.first.swap(ip);
-    IP_port.second = port;
+    if (af == AF_INET6 && addr.ss_family == AF_INET)
+    {
+        sockaddr_in AddrIN = *reinterpret_cast<const sockaddr_in*>(&addr); // ,  
+        sockaddr_in6* p_AddrIN6 = reinterpret_cast<sockaddr_in6*>(&addr);
+        memset(p_AddrIN6, 0, sizeof(sockaddr_in6));
+        p_AddrIN6->sin6_family = AF_INET6;
+        p_AddrIN6->sin6_port = AddrIN.sin_port;
+        p_AddrIN6->sin6_addr.s6_addr[10] = 0xff;
+        p_AddrIN6->sin6_addr.s6_addr[11] = 0xff;
+        memcpy(&p_AddrIN6->sin6_addr.s6_addr[12], &AddrIN.sin_addr, sizeof(AddrIN.sin_addr));
+    }
+
+    if (addr.ss_family == AF_INET)
+        return socklen_t(sizeof(sockaddr_in));
+    if (addr.ss_family == AF_INET6)
+        return socklen_t(sizeof(sockaddr_in6));
+    return socklen_t(sizeof(sockaddr_storage));
 }
 
 /// <summary>
 ///    
 /// </summary>
 /// <param name="logger"> -     </param>
-network::sockInfo_t::sockInfo_t(log_t& logger) : RAII_OSsock(logger), logger(logger)
+network::sockInfo_t::sockInfo_t(log_t& logger) : RAII_OSsock(logger), b_IPvalid(false), logger(logger)
 {
-    memset(&Addr, 0, sizeof(Addr));
-    IP_port.first.clear();
-    IP_port.second = 0;
-    sizeAddr = sizeof(Addr);
+    ResetSockInfo();
 }
 
 /// <summary>
@@ -156,32 +198,41 @@ network::sockInfo_t::sockInfo_t(std::string ip, unsigned short port, log_t& logg
 /// </summary>
 network::sockInfo_t::~sockInfo_t()
 {
-    memset(&Addr, 0, sizeof(Addr));
-    IP_port.first.clear();
-    IP_port.second = 0;
+    ResetSockInfo();
 }
 
 /// <summary>
 ///     
 /// </summary>
-/// <param name="ip"> - IP    "..." </param>
+/// <param name="ip"> - IP    "..."  IPv6 ( ':') </param>
 /// <param name="port"> -  </param>
 /// <returns> true - ; false -  </returns>
 bool network::sockInfo_t::setSockInfo(std::string ip, unsigned short port)
 {
     bool result = false; // 
 
-    sockaddr_in AddrIN; //        IP
-    AddrIN.sin_family = AF_INET; //  
-    AddrIN.sin_port = htons(port); //    
-    //  htons       TCP/IP
+    sockaddr_storage AddrIP; //        IP
+    memset(&AddrIP, 0, sizeof(AddrIP));
+    int inet_pton_state = 0;
 
-    //AddrIN.sin_addr -  IN_ADDR ,    IPv4.
-    // :
+    //sin_addr/sin6_addr -  , :
     // NADDR_ANY    (0.0.0.0);
     // INADDR_LOOPBAC  loopback (127.0.0.1);
     // INADDR_BROADCAST  (255.255.255.255)
-    int inet_pton_state = inet_pton(AF_INET, ip.c_str(), &AddrIN.sin_addr);
+    if (GetFamily(ip) == AF_INET)
+    {
+        sockaddr_in* p_AddrIN = reinterpret_cast<sockaddr_in*>(&AddrIP);
+        p_AddrIN->sin_family = AF_INET; //  
+        p_AddrIN->sin_port = htons(port); //         TCP/IP
+        inet_pton_state = inet_pton(AF_INET, ip.c_str(), &p_AddrIN->sin_addr);
+    }
+    else
+    {
+        sockaddr_in6* p_AddrIN6 = reinterpret_cast<sockaddr_in6*>(&AddrIP);
+        p_AddrIN6->sin6_family = AF_INET6;
+        p_AddrIN6->sin6_port = htons(port);
+        inet_pton_state = inet_pton(AF_INET6, ip.c_str(), &p_AddrIN6->sin6_addr);
+    }
     //  InetPton    IPv4  IPv6   
     //     
     //  1 - , 0 -  , -1 - 
@@ -189,10 +240,10 @@ bool network::sockInfo_t::setSockInfo(std::string ip, unsigned short port)
     //    
     if (inet_pton_state == 1) //  
     {
-        memset(&Addr, 0, SizeAddr());
-        memmove(&Addr, &AddrIN, SizeAddr()); //AddrIN ==>> Addr
+        memcpy(&Addr, &AddrIP, sizeof(Addr)); //AddrIP ==>> Addr
+        s_IP.swap(ip); //    -    
+        b_IPvalid = true;
         result = true;
-        UpdateSockInfo(ip, port);
     }
     else if (inet_pton_state == 0) //   IP
         logger.doLog(std::string("setSockAddr Fail, invalid IP: ") + ip);
@@ -213,9 +264,13 @@ bool network::sockInfo_t::setSockInfo(std::string ip, unsigned short port)
 /// <param name="sockInfo"> -        IP </param>
 void network::sockInfo_t::setSockInfo(const sockInfo_t& sockInfo)
 {
-    memset(&Addr, 0, SizeAddr());
-    memmove(&Addr, &sockInfo.Addr, SizeAddr());
-    IP_port = sockInfo.IP_port;
+    if (this == &sockInfo)
+        return;
+
+    memcpy(&Addr, &sockInfo.Addr, sizeof(Addr));
+    b_IPvalid = sockInfo.b_IPvalid;
+    if (b_IPvalid) //      ,    
+        s_IP = sockInfo.s_IP;
 }
 
 /// <summary>
@@ -224,25 +279,61 @@ void network::sockInfo_t::setSockInfo(const sockInfo_t& sockInfo)
 /// <returns>       </returns>
 const sockaddr* network::sockInfo_t::getSockAddr() const
 {
-    return &Addr;
+    return reinterpret_cast<const sockaddr*>(&Addr);
 }
 
 /// <summary>
 ///      
 /// </summary>
-/// <returns>     </returns>
+/// <returns>     (  ) </returns>
 size_t network::sockInfo_t::SizeAddr() const
 {
-    return sizeAddr;
+    switch (Addr.ss_family)
+    {
+    case AF_INET:
+        return sizeof(sockaddr_in);
+    case AF_INET6:
+        return sizeof(sockaddr_in6);
+    default:
+        return sizeof(sockaddr_storage);
+    }
 }
 
 /// <summary>
-///   IP
+///   IP.          
 /// </summary>
-/// <returns> IP    "..." </returns>
-std::string network::sockInfo_t::GetIP() const
+/// <returns> IP    "..."  IPv6,   -    </returns>
+const std::string& network::sockInfo_t::GetIP() const
 {
-    return IP_port.first;
+    if (!b_IPvalid)
+    {
+        char bufIP[INET6_ADDRSTRLEN];//    IP
+        const char* p_IP = nullptr;
+
+        //  InetNtop  - IPv4  IPv6      
+        if (Addr.ss_family == AF_INET)
+            p_IP = inet_ntop(AF_INET, &reinterpret_cast<const sockaddr_in*>(&Addr)->sin_addr, bufIP, sizeof(bufIP));
+        else if (Addr.ss_family == AF_INET6)
+        {
+            const in6_addr& addr6 = reinterpret_cast<const sockaddr_in6*>(&Addr)->sin6_addr;
+            if (IN6_IS_ADDR_V4MAPPED(&addr6)) //  IPv4     -   IPv4
+                p_IP = inet_ntop(AF_INET, &addr6.s6_addr[12], bufIP, sizeof(bufIP));
+            else
+                p_IP = inet_ntop(AF_INET6, &addr6, bufIP, sizeof(bufIP));
+        }
+
+        if (p_IP != nullptr)
+            s_IP.assign(p_IP);
+        else
+        {
+            s_IP.clear();
+            if (Addr.ss_family != AF_UNSPEC) //  
+                logger.doLog("inet_ntop fail", GetError());
+        }
+        b_IPvalid = true;
+    }
+
+    return s_IP;
 }
 
 /// <summary>
@@ -251,7 +342,30 @@ std::string network::sockInfo_t::GetIP() const
 /// <returns>   </returns>
 unsigned short network::sockInfo_t::GetPort() const
 {
-    return IP_port.second;
+    if (Addr.ss_family == AF_INET)
+        return ntohs(reinterpret_cast<const sockaddr_in*>(&Addr)->sin_port);
+    if (Addr.ss_family == AF_INET6)
+        return ntohs(reinterpret_cast<const sockaddr_in6*>(&Addr)->sin6_port);
+    return 0;
+}
+
+/// <summary>
+///    ,      
+/// </summary>
+/// <returns> AF_INET6 -  IPv6; AF_INET -  IPv4    </returns>
+int network::sockInfo_t::GetFamily() const
+{
+    return Addr.ss_family == AF_INET6 ? AF_INET6 : AF_INET;
+}
+
+/// <summary>
+///       IP
+/// </summary>
+/// <param name="ip"> - IP    "..."  IPv6 ( ':') </param>
+/// <returns> AF_INET6 -  IPv6; AF_INET -  </returns>
+int network::sockInfo_t::GetFamily(const std::string& ip)
+{
+    return ip.find(':') == std::string::npos ? AF_INET : AF_INET6;
 }
 
 /// <summary>
@@ -260,8 +374,26 @@ unsigned short network::sockInfo_t::GetPort() const
 /// <param name="rValue"> -   </param>
 /// <returns> 1 -   </returns>
 bool network::sockInfo_t::operator == (const sockInfo_t& rValue) const
-{//    sockaddr ( )
-    return getSockAddr() == rValue.getSockAddr();
+{//   : ,     ( IPv6  )
+    if (Addr.ss_family != rValue.Addr.ss_family)
+        return false;
+
+    if (Addr.ss_family == AF_INET)
+    {
+        const sockaddr_in* p_left = reinterpret_cast<const sockaddr_in*>(&Addr);
+        const sockaddr_in* p_right = reinterpret_cast<const sockaddr_in*>(&rValue.Addr);
+        return p_left->sin_port == p_right->sin_port &&
+            memcmp(&p_left->sin_addr, &p_right->sin_addr, sizeof(p_left->sin_addr)) == 0;
+    }
+    if (Addr.ss_family == AF_INET6)
+    {
+        const sockaddr_in6* p_left = reinterpret_cast<const sockaddr_in6*>(&Addr);
+        const sockaddr_in6* p_right = reinterpret_cast<const sockaddr_in6*>(&rValue.Addr);
+        return p_left->sin6_port == p_right->sin6_port && p_left->sin6_scope_id == p_right->sin6_scope_id &&
+            memcmp(&p_left->sin6_addr, &p_right->sin6_addr, sizeof(p_left->sin6_addr)) == 0;
+    }
+
+    return Addr.ss_family == AF_UNSPEC; //   ,    
 }
 
 /// <summary>
@@ -274,6 +406,40 @@ bool network::sockInfo_t::operator != (const sockInfo_t& rValue) const
     return !(*this == rValue);
 }
 
+/// <summary>
+///       (, , )
+/// </summary>
+/// <returns> ,   operator == </returns>
+size_t network::sockInfo_t::Hash() const
+{
+    const unsigned char* p_data = nullptr; //    ,   operator ==
+    size_t size = 0;
+    unsigned short port = 0;
+
+    if (Addr.ss_family == AF_INET)
+    {
+        const sockaddr_in* p_AddrIN = reinterpret_cast<const sockaddr_in*>(&Addr);
+        p_data = reinterpret_cast<const unsigned char*>(&p_AddrIN->sin_addr);
+        size = sizeof(p_AddrIN->sin_addr);
+        port = p_AddrIN->sin_port;
+    }
+    else if (Addr.ss_family == AF_INET6)
+    {
+        const sockaddr_in6* p_AddrIN6 = reinterpret_cast<const sockaddr_in6*>(&Addr);
+        p_data = reinterpret_cast<const unsigned char*>(&p_AddrIN6->sin6_addr);
+        size = sizeof(p_AddrIN6->sin6_addr);
+        port = p_AddrIN6->sin6_port;
+    }
+
+    unsigned long long hash = 14695981039346656037ULL; // FNV-1a
+    hash = (hash ^ Addr.ss_family) * 1099511628211ULL;
+    hash = (hash ^ port) * 1099511628211ULL;
+    for (size_t index = 0; index < size; ++index)
+        hash = (hash ^ p_data[index]) * 1099511628211ULL;
+
+    return size_t(hash);
+}
+
 /// <summary>
 ///     (     TCP)
 /// </summary>
@@ -290,9 +456,12 @@ bool network::socket_t::SetSocket(SOCKET socket, bool nonBlock)
             Socket = socket;
             this->nonBlock = nonBlock; // accept    
             //    
-            int sizeAddr = SizeAddr();
+            socklen_t sizeAddr = sizeof(sockaddr_storage);
             if (!getsockname(Socket, setSockAddr(), &sizeAddr))
+            {
                 UpdateSockInfo();//   setSockAddr()
+                af = Addr.ss_family; //     
+            }
             else
                 logger.doLog("getsockname fail", GetError());
 
@@ -309,13 +478,19 @@ bool network::socket_t::SetSocket(SOCKET socket, bool nonBlock)
 bool network::socket_t::Close()
 {
     if (CheckValidSocket(false)) //   
+    { //      -        
+        for (size_t index = 0; index < v_manager.size(); ++index)
+            v_manager[index]->Forget(int(Socket));
+        v_manager.clear();
         if (CLOSE_SOCKET(Socket)) // 
             logger.doLog("closesocket fail", GetError());
         else
         {
             Socket = INVALID_SOCKET; //  
-            UpdateSockInfo("", 0); //  
+            af = AF_UNSPEC;
+            ResetSockInfo(); //  
         }
+    }
 
     return Socket == INVALID_SOCKET;
 }
@@ -325,19 +500,22 @@ bool network::socket_t::Close()
 ///   ,    ,   
 ///     -.
 ///        .
+///  IPv6       (IPV6_V6ONLY = 0):  "::",    IPv4.
 /// </summary>
 /// <returns> true - , false -  </returns>
 bool network::socket_t::Bind()
 {
     bool result = false;//
 
-    if (CheckValidSocket() && !IP_port.first.empty() && IP_port.second != 0) //      
+    if (CheckValidSocket() && Addr.ss_family != AF_UNSPEC && GetPort() != 0) //      
     {
-        result = (bind(Socket, getSockAddr(), SizeAddr()) == 0); //    IP  
+        if (af == AF_INET6) //     bind;    IPv6  ,    
+            setSocketOpt(Socket, option_t::DUAL_STACK, logger);
+        result = (bind(Socket, getSockAddr(), socklen_t(SizeAddr())) == 0); //    IP  
         if (result) //  
-            DEBUG_TRACE(logger, "bind -> ok " + IP_port.first + '.' + std::to_string(IP_port.second));
+            DEBUG_TRACE(logger, "bind -> ok " + GetIP() + '.' + std::to_string(GetPort()));
         else
-            logger.doLog("bind -> fail " + IP_port.first + '.' + std::to_string(IP_port.second), GetError());
+            logger.doLog("bind -> fail " + GetIP() + '.' + std::to_string(GetPort()), GetError());
     }
     else //   Bind()      
         logger.doLog("bind invalid IP_port");
@@ -364,14 +542,14 @@ bool network::socket_t::Bind(std::string ip, unsigned short port)
 ///    ,       
 /// </summary>
 /// <param name="logger"> -    </param>
-network::socket_t::socket_t(log_t& logger) : sockInfo_t(logger), Socket(INVALID_SOCKET), nonBlock(false)
+network::socket_t::socket_t(log_t& logger) : sockInfo_t(logger), Socket(INVALID_SOCKET), af(AF_UNSPEC), nonBlock(false)
 {}
 
 /// <summary>
 ///   4- 
 /// </summary>
 /// <param name="af"> -  :       .     IPv4.
-///    AF_INET </param>
+///    AF_INET,  IPv6 - AF_INET6 </param>
 /// <param name="type"> -  :      TCP (SOCK_STREAM)  UDP (SOCK_DGRAM).
 ///       "" ,        .
 ///    SOCK_RAW </param>
@@ -381,14 +559,15 @@ network::socket_t::socket_t(log_t& logger) : sockInfo_t(logger), Socket(INVALID_
 network::socket_t::socket_t(int af, int type, int protocol, log_t& logger) : socket_t(logger)
 {
     Socket = socket(af, type, protocol); //         
-    CheckValidSocket(); //   
+    if (CheckValidSocket()) //   
+        this->af = af;
 }
 
 /// <summary>
 ///    6 
 /// </summary>
 /// <param name="af"> -  :       .     IPv4.
-///    AF_INET </param>
+///    AF_INET,  IPv6 - AF_INET6 </param>
 /// <param name="type"> -  :      TCP (SOCK_STREAM)  UDP (SOCK_DGRAM).
 ///       "" ,        .
 ///    SOCK_RAW </param>
@@ -406,7 +585,7 @@ network::socket_t::socket_t(int af, int type, int protocol, std::string ip, unsi
 ///    5 
 /// </summary>
 /// <param name="af"> -  :       .     IPv4.
-///    AF_INET </param>
+///    AF_INET,  IPv6 - AF_INET6 </param>
 /// <param name="type"> -  :      TCP (SOCK_STREAM)  UDP (SOCK_DGRAM).
 ///       "" ,        .
 ///    SOCK_RAW </param>
@@ -486,11 +665,18 @@ void network::TCP_socketClient_t::Move(TCP_socketClient_t& source)
     {
         serverInfo.setSockInfo(source.serverInfo);
         b_connected = source.b_connected;
+        b_zeroCopy = source.b_zeroCopy;
+        zeroCopyNext = source.zeroCopyNext;
+        d_zeroCopy.swap(source.d_zeroCopy); //        
         source.b_connected = false;
+        source.b_zeroCopy = false;
+        source.zeroCopyNext = 0;
+        source.d_zeroCopy.clear();
         source.Socket = INVALID_SOCKET;
+        source.af = AF_UNSPEC;
         source.nonBlock = false;
-        source.serverInfo.UpdateSockInfo("", 0);
-        source.UpdateSockInfo("", 0);
+        source.serverInfo.ResetSockInfo();
+        source.ResetSockInfo();
     }
 }
 
@@ -498,16 +684,16 @@ void network::TCP_socketClient_t::Move(TCP_socketClient_t& source)
 ///   1 
 /// </summary>
 /// <param name="logger"> -    </param>
-network::TCP_socketClient_t::TCP_socketClient_t(log_t& logger) : socket_t(logger), b_connected(false), serverInfo(logger)
+network::TCP_socketClient_t::TCP_socketClient_t(log_t& logger) : socket_t(logger), b_connected(false), serverInfo(logger), b_zeroCopy(false), zeroCopyNext(0)
 {}
 
 /// <summary>
 ///   3 
 /// </summary>
-/// <param name="ip_server"> - IP     "..." </param>
+/// <param name="ip_server"> - IP     "..."  IPv6,      </param>
 /// <param name="port_server"> -    </param>
 /// <param name="logger"> -   </param>
-network::TCP_socketClient_t::TCP_socketClient_t(std::string ip_server, unsigned short port_server, log_t& logger) : socket_t(AF_INET, SOCK_STREAM, 0, logger), b_connected(false), serverInfo(logger)
+network::TCP_socketClient_t::TCP_socketClient_t(std::string ip_server, unsigned short port_server, log_t& logger) : socket_t(GetFamily(ip_server), SOCK_STREAM, 0, logger), b_connected(false), serverInfo(logger), b_zeroCopy(false), zeroCopyNext(0)
 {
     if (serverInfo.setSockInfo(ip_server, port_server)) //      
         Connected(); //    
@@ -516,9 +702,9 @@ network::TCP_socketClient_t::TCP_socketClient_t(std::string ip_server, unsigned
 /// <summary>
 ///   2 
 /// </summary>
-/// <param name="serverSockInfo"> -    </param>
+/// <param name="serverSockInfo"> -   ,       </param>
 /// <param name="logger"> -   </param>
-network::TCP_socketClient_t::TCP_socketClient_t(sockInfo_t serverSockInfo, log_t& logger) : socket_t(AF_INET, SOCK_STREAM, 0, logger), b_connected(false), serverInfo(logger)
+network::TCP_socketClient_t::TCP_socketClient_t(sockInfo_t serverSockInfo, log_t& logger) : socket_t(serverSockInfo.GetFamily(), SOCK_STREAM, 0, logger), b_connected(false), serverInfo(logger), b_zeroCopy(false), zeroCopyNext(0)
 {
     serverInfo.setSockInfo(serverSockInfo); //    
     Connected(); //  
@@ -541,26 +727,24 @@ int network::TCP_socketClient_t::Recive(std::string& str_bufer, const std::strin
     //   
     if (b_connected && CheckValidSocket(false))
     {
-        str_bufer.clear(); //   
-        std::string tempStr(2048, '\0'); //       
+        str_bufer.clear(); //   ,     
+        const size_t CHUNK = 2048; //   
         int reciveSize = 0; //   
         bool EOM = str_EndOfMessege.empty() && (sizeMsg == 0); // EndOfMessege   
         //   
         do {
-            reciveSize = recv(Socket, &tempStr[0], tempStr.size(), 0); //       .
+            size_t oldSize = str_bufer.size();
+            str_bufer.resize(oldSize + CHUNK); //     ,   
+            reciveSize = recv(Socket, &str_bufer[oldSize], CHUNK, 0); //       .
+            str_bufer.resize(oldSize + (reciveSize > 0 ? reciveSize : 0)); //   , '\0'   
 
             if (reciveSize > 0)
             {//   
-                DEBUG_TRACE(logger, "Recive msg: " + tempStr)
-                    tempStr.assign(tempStr.c_str()); //    '\0';
-                str_bufer += tempStr; //   
-                tempStr.clear(); //  
-
-                if (!str_EndOfMessege.empty())
-                { //   EOM
-                    int pos = str_bufer.size() - str_EndOfMessege.size(); //     
-                    if (pos >= 0) //   
-                        EOM = (str_bufer.rfind(str_EndOfMessege) == pos); //     
+                DEBUG_TRACE(logger, "Recive msg: " + str_bufer.substr(oldSize))
+
+                if (!str_EndOfMessege.empty() && str_bufer.size() >= str_EndOfMessege.size())
+                { //   EOM -    ,      
+                    EOM = str_bufer.compare(str_bufer.size() - str_EndOfMessege.size(), str_EndOfMessege.size(), str_EndOfMessege) == 0;
                 }
                 if (sizeMsg != 0) //    
                     EOM |= (str_bufer.size() >= sizeMsg); // ,      
@@ -594,6 +778,61 @@ int network::TCP_socketClient_t::Recive(std::string& str_bufer, const std::strin
     return result;
 }
 
+/// <summary>
+///        ,    (  )
+/// </summary>
+/// <param name="buffer"> -     </param>
+/// <returns> N>0 -  N ;
+///           -1 -  ;
+///           -2 -     ;
+///           -3 -    ( )</returns>
+int network::TCP_socketClient_t::Recive(slice_t buffer)
+{
+    int result = -2;
+    //   
+    if (b_connected && CheckValidSocket(false) && buffer.size != 0)
+    {
+        result = recv(Socket, buffer.data, int(buffer.size), 0);
+        if (result > 0)
+            DEBUG_TRACE(logger, "Recive msg: " + std::string(buffer.data, result));
+        else if (result < 0)
+        {   //    , ,    
+            if (nonBlock && GetError() == error_t::NON_BLOCK_SOCKET_NOT_READY)
+                result = -3; //   ,  
+            else
+            {   //   , 
+                logger.doLog("TCP_socketClient_t::Recive() fail, errno: ", GetError());
+                result = -1; //  
+                b_connected = false; //   
+            }
+        }
+        else
+        {
+            result = -2; //  
+            b_connected = false;
+        }
+    }
+
+    return result;
+}
+
+/// <summary>
+///         
+/// </summary>
+/// <param name="buffer"> -  ,      </param>
+/// <param name="minSize"> -       </param>
+/// <returns> N>0 -  N ;
+///           -1 -  ;
+///           -2 -     ;
+///           -3 -    ( )</returns>
+int network::TCP_socketClient_t::Recive(buffer_t& buffer, size_t minSize)
+{
+    int result = Recive(buffer.WriteSlice(minSize));
+    if (result > 0)
+        buffer.Commit(result);
+    return result;
+}
+
 /// <summary>
 ///            
 /// </summary>
@@ -613,7 +852,7 @@ int network::TCP_socketClient_t::Send(const std::string& str_bufer)
         int sendSize = 0; //    
         //  
         do {
-            int tempSize = send(Socket, &str_bufer[sendSize], totalSendSize - sendSize, 0); //       
+            int tempSize = send(Socket, &str_bufer[sendSize], totalSendSize - sendSize, SEND_NOSIGNAL); //       
             if (tempSize > 0)
             { //    
                 DEBUG_TRACE(logger, std::string(&str_bufer[sendSize], tempSize));
@@ -646,307 +885,1286 @@ int network::TCP_socketClient_t::Send(const std::string& str_bufer)
 }
 
 /// <summary>
-///      
+///          (writev/WSASend)    
+///  .    ,  -   
 /// </summary>
-/// <returns> 1 -   </returns>
-bool network::TCP_socketClient_t::Connected()
+/// <param name="parts"> -     </param>
+/// <param name="count"> -   </param>
+/// <param name="more"> -      (MSG_MORE) </param>
+/// <returns> 0 -   ;
+///           N>0 -  N ;
+///           -1 -  ;
+///           -2 -     ;
+///           -3 -      ( )</returns>
+int network::TCP_socketClient_t::Send(const slice_t* parts, size_t count, bool more)
 {
-    //   
-    if (CheckValidSocket(false) && !b_connected)
-    {   //      -   TCP -      SYN
-        if (0 != connect(Socket, serverInfo.getSockAddr(), serverInfo.SizeAddr()))
-            logger.doLog("TCP_socketClient_t non connected with server:", GetError());
-        else
-        {   //    ,     (  )
-            b_connected = true;
-            UpdateSockInfo();
+    int result = -1;
+    //   
+    if (b_connected && CheckValidSocket(false))
+    {
+        size_t totalSendSize = 0; //    
+        for (size_t index = 0; index < count; ++index)
+            totalSendSize += parts[index].size;
+        size_t sendSize = 0; //    
+        size_t part = 0; //   
+        size_t offset = 0; //      
+        result = 0; //    
+#ifdef __WIN32__
+        WSABUF vec[PARTS_MAX]; //     
+#else
+        iovec vec[PARTS_MAX];
+#endif
+        //  :    ,    ,      
+        while (totalSendSize > sendSize)
+        {
+            size_t size = 0; //     
+            size_t index = part; //  ,     
+            for (; index < count && size < PARTS_MAX; ++index)
+                if (parts[index].size != 0)
+                {
+                    size_t skip = (index == part) ? offset : 0; //        
+#ifdef __WIN32__
+                    vec[size].buf = parts[index].data + skip;
+                    vec[size].len = ULONG(parts[index].size - skip);
+#else
+                    vec[size].iov_base = parts[index].data + skip;
+                    vec[size].iov_len = parts[index].size - skip;
+#endif
+                    ++size;
+                }
+
+#ifdef __WIN32__
+            DWORD bytes = 0; //   / WSASend   send
+            int tempSize = WSASend(Socket, vec, DWORD(size), &bytes, 0, nullptr, nullptr) == 0 ? int(bytes) : -1;
+#else
+            msghdr msg;
+            memset(&msg, 0, sizeof(msg));
+            msg.msg_iov = vec;
+            msg.msg_iovlen = size;
+            //  ,           
+            int tempSize = sendmsg(Socket, &msg, ((more || index < count) ? MSG_MORE : 0) | SEND_NOSIGNAL);
+#endif
+            if (tempSize > 0)
+            { //     -     
+                sendSize += tempSize;
+                for (size_t left = tempSize; left != 0 && part < count; )
+                {
+                    size_t rest = parts[part].size - offset; //    
+                    if (left >= rest)
+                    {
+                        left -= rest;
+                        ++part;
+                        offset = 0;
+                    }
+                    else
+                    {
+                        offset += left;
+                        left = 0;
+                    }
+                }
+                result = (totalSendSize == sendSize) ? 0 : int(sendSize); //   ?
+            }
+            else if (tempSize < 0)
+            {//    , ,     
+                if (nonBlock && GetError() == error_t::NON_BLOCK_SOCKET_NOT_READY)
+                    result = sendSize ? int(sendSize) : -3; //  ,   
+                else //  ,     ,   
+                {
+                    logger.doLog("TCP_socketClient_t::Send() fail, errno: ", GetError());
+                    result = -1; //  
+                    b_connected = false; //   
+                }
+                break;
+            }
+            else
+            {
+                result = -1;
+                break;
+            }
         }
     }
+    else
+        result = -2; //  
 
-    return b_connected;
-}
-/// <summary>
-///    
-/// </summary>
-/// <returns> 1 -   </returns>
-bool network::TCP_socketClient_t::GetConnected() const
-{
-    return b_connected;
-}
-
-/// <summary>
-///   3- 
-/// </summary>
-/// <param name="ip"> - IP    "..." </param>
-/// <param name="port"> -   </param>
-/// <param name="logger"> -   </param>
-network::TCP_socketServer_t::TCP_socketServer_t(std::string ip, unsigned short port, log_t& logger) : socket_t(AF_INET, SOCK_STREAM, 0, ip, port, logger)
-{ // listen    ,      
-    if (CheckValidSocket(false))
-        if (0 != listen(Socket, SOMAXCONN))
-            this->logger.doLog("TCP_socketServer_t listen fali ", GetError());
+    return result;
 }
 
 /// <summary>
-///   2- 
+///         
 /// </summary>
-/// <param name="sockInfo"> -    </param>
-/// <param name="logger"> -   </param>
-network::TCP_socketServer_t::TCP_socketServer_t(sockInfo_t sockInfo, log_t& logger) : socket_t(AF_INET, SOCK_STREAM, 0, sockInfo, logger)
+/// <param name="parts"> -     </param>
+/// <param name="more"> -      (MSG_MORE) </param>
+/// <returns>  Send(parts, count, more) </returns>
+int network::TCP_socketClient_t::Send(const std::vector<slice_t>& parts, bool more)
 {
-    if (CheckValidSocket(false))
-        if (0 != listen(Socket, SOMAXCONN))
-            this->logger.doLog("TCP_socketServer_t listen fali ", GetError());
+    return Send(parts.empty() ? nullptr : &parts[0], parts.size(), more);
 }
 
 /// <summary>
-///    
+///  ""  (TCP_CORK)
 /// </summary>
-/// <param name="client"> -         </param>
-/// <returns> 0 -   ,
-///          -1 -  ,
-///          -2 -       ( )</returns>
-///			 -3 -   ( )    
-int network::TCP_socketServer_t::AddClient(TCP_socketClient_t& client)
+/// <param name="enable"> - 1 - ; 0 -     </param>
+/// <returns> 1 -   </returns>
+bool network::TCP_socketClient_t::SetCork(bool enable)
 {
-    int result = -1;
+    bool result = false;
 
-    if (!client.CheckValidSocket(false) && CheckValidSocket(false))
+    if (CheckValidSocket(false))
     {
-        sockInfo_t tempInfo(logger); //    
-        int sizeAddr = tempInfo.SizeAddr(); //  
-        //       .         .
-        //     ,   accept   -,  
-        //     .
-        SOCKET tempSocket = accept(Socket, tempInfo.setSockAddr(), &sizeAddr);
-        if (tempSocket != INVALID_SOCKET)
-        { //     ,   
-            tempInfo.UpdateSockInfo(); //    
-            if (client.SetSocket(tempSocket, tempInfo))
-            { //  ?    
-                DEBUG_TRACE(logger, "addClient success" + tempInfo.GetIP() + std::to_string(tempInfo.GetPort()))
-                    result = 0;
-            }
-            else //     
-                logger.doLog("fail SetSocket in addClient", GetError());
-        } //                     
-        else if (GetError() == error_t::NON_BLOCK_SOCKET_NOT_READY && nonBlock)
-            result = -2;
+#if !defined(__WIN32__) && defined(TCP_CORK)
+        int cork = enable ? 1 : 0;
+        if (setsockopt(Socket, IPPROTO_TCP, TCP_CORK, &cork, sizeof(cork)))
+            logger.doLog("TCP_socketClient_t - setsockopt TCP_CORK ", GetError());
         else
-            logger.doLog("accept fail", GetError()); //    
+            result = true;
+#else //  Windows  ,     Send(parts, count)
+        logger.doLog("TCP_socketClient_t - TCP_CORK not supported");
+#endif
     }
-    else
-        result = -3;
 
     return result;
 }
 
 /// <summary>
-///     ()  
+///          (Linux - sendfile)
 /// </summary>
-/// <param name="source"> -     -        </param>
-void network::UDP_socket_t::Move(UDP_socket_t& source)
+/// <param name="file"> -   </param>
+/// <param name="offset"> -   ,    </param>
+/// <param name="count"> -   ,    </param>
+/// <returns> 0 -      ;
+///           N>0 -  N ,      ( );
+///           -1 -  ;
+///           -2 -     ;
+///           -3 -      ( )</returns>
+int network::TCP_socketClient_t::SendFile(FILE_HANDLE file, long long& offset, size_t& count)
 {
-    if (Close() && socket_t::SetSocket(source.Socket, source.nonBlock))
+    int result = -2;
+    //   
+    if (b_connected && CheckValidSocket(false))
     {
-        lastCommunicationSocket.setSockInfo(source.lastCommunicationSocket);
-        source.Socket = INVALID_SOCKET;
-        source.nonBlock = false;
-        source.lastCommunicationSocket.UpdateSockInfo("", 0);
-        source.UpdateSockInfo("", 0);
-    }
-}
-
-/// <summary>
-///   MTU
-/// </summary>
-void network::UDP_socket_t::setMTU()
-{
-    int optlen = sizeof(u32_MTU); //  
-    // getsockopt      ,     ,   
-    if (getsockopt(Socket, SOL_SOCKET, SO_MAX_MSG_SIZE, (char*)(&u32_MTU), &optlen))
-        logger.doLog("getsockopt fail ", GetError());
-}
-
+        size_t sendSize = 0; //    
+        result = 0;
+        while (count != 0)
+        {
+            size_t chunk = count < 0x40000000 ? count : 0x40000000; //      1 ,     int
+#ifdef __WIN32__
+            char buffer[16384]; //   sendfile    -   
+            OVERLAPPED position; //        
+            memset(&position, 0, sizeof(position));
+            position.Offset = DWORD(offset);
+            position.OffsetHigh = DWORD((unsigned long long)offset >> 32);
+            DWORD readSize = 0;
+            if (!ReadFile(file, buffer, DWORD(chunk < sizeof(buffer) ? chunk : sizeof(buffer)), &readSize, &position) && GetLastError() != ERROR_HANDLE_EOF)
+            {
+                logger.doLog("TCP_socketClient_t::SendFile() ReadFile fail, errno: ", int(GetLastError()));
+                result = -1;
+                break;
+            }
+            //       -     
+            int tempSize = readSize ? send(Socket, buffer, int(readSize), 0) : 0;
+#else
+            off_t position = offset;
+            int tempSize = int(sendfile(Socket, file, &position, chunk));
+#endif
+            if (tempSize > 0)
+            {
+                offset += tempSize;
+                count -= tempSize;
+                sendSize += tempSize;
+            }
+            else if (tempSize < 0)
+            {//    , ,     
+                if (nonBlock && GetError() == error_t::NON_BLOCK_SOCKET_NOT_READY)
+                    result = sendSize ? int(sendSize) : -3; //  ,   
+                else
+                {
+                    logger.doLog("TCP_socketClient_t::SendFile() fail, errno: ", GetError());
+                    result = -1;
+                }
+                break;
+            }
+            else
+                break; //   
+        }
+    }
+
+    return result;
+}
+
+/// <summary>
+///      (pipe)        (Linux - splice)
+/// </summary>
+/// <param name="pipe"> -     </param>
+/// <param name="count"> -   ,    </param>
+/// <returns> 0 -       ;
+///           N>0 -  N ,    ( );
+///           -1 -   ( Windows -  );
+///           -2 -     ;
+///           -3 -      ( )</returns>
+int network::TCP_socketClient_t::SendPipe(int pipe, size_t& count)
+{
+    int result = -2;
+    //   
+    if (b_connected && CheckValidSocket(false))
+    {
+#ifdef __WIN32__
+        logger.doLog("TCP_socketClient_t - splice not supported");
+        result = -1;
+#else
+        size_t sendSize = 0; //    
+        result = 0;
+        while (count != 0)
+        {
+            size_t chunk = count < 0x40000000 ? count : 0x40000000;
+            //      ;        
+            int tempSize = int(splice(pipe, nullptr, Socket, nullptr, chunk, SPLICE_F_MOVE | (nonBlock ? SPLICE_F_NONBLOCK : 0)));
+            if (tempSize > 0)
+            {
+                count -= tempSize;
+                sendSize += tempSize;
+            }
+            else if (tempSize < 0)
+            {
+                if (nonBlock && GetError() == error_t::NON_BLOCK_SOCKET_NOT_READY)
+                    result = sendSize ? int(sendSize) : -3;
+                else
+                {
+                    logger.doLog("TCP_socketClient_t::SendPipe() fail, errno: ", GetError());
+                    result = -1;
+                }
+                break;
+            }
+            else
+                break; //    
+        }
+#endif
+    }
+
+    return result;
+}
+
+/// <summary>
+///       (Linux - SO_ZEROCOPY)
+/// </summary>
+/// <param name="enable"> - 1 - ; 0 -  </param>
+/// <returns> 1 -   </returns>
+bool network::TCP_socketClient_t::SetZeroCopy(bool enable)
+{
+    bool result = false;
+
+    if (CheckValidSocket(false))
+    {
+#ifdef __WIN32__
+        logger.doLog("TCP_socketClient_t - SO_ZEROCOPY not supported");
+#else
+        int zeroCopy = 1; //     MSG_ZEROCOPY,  ,   
+        if (enable && setsockopt(Socket, SOL_SOCKET, SO_ZEROCOPY, &zeroCopy, sizeof(zeroCopy)))
+            logger.doLog("TCP_socketClient_t - setsockopt SO_ZEROCOPY ", GetError());
+        else
+        {
+            b_zeroCopy = enable;
+            result = true;
+        }
+#endif
+    }
+
+    return result;
+}
+
+/// <summary>
+///        (MSG_ZEROCOPY)
+/// </summary>
+/// <param name="buffer"> -    </param>
+/// <param name="offset"> -     (   ) </param>
+/// <returns> 0 -   ;
+///           N>0 -  N ;
+///           -1 -  ;
+///           -2 -     ;
+///           -3 -      ( )</returns>
+int network::TCP_socketClient_t::SendZeroCopy(const std::shared_ptr<const std::string>& buffer, size_t offset)
+{
+    if (buffer == nullptr || offset > buffer->size())
+        return -2;
+
+    slice_t part(const_cast<char*>(buffer->data()) + offset, buffer->size() - offset); // Send   
+    if (!b_zeroCopy)
+        return Send(&part, 1);
+
+    int result = -2;
+    //   
+    if (b_connected && CheckValidSocket(false))
+    {
+        size_t sendSize = 0; //    
+        int flags = MSG_ZEROCOPY | SEND_NOSIGNAL;
+        result = 0;
+        //  
+        while (part.size > sendSize)
+        {
+            int tempSize = send(Socket, part.data + sendSize, part.size - sendSize, flags);
+            if (tempSize > 0)
+            {
+                if (flags & MSG_ZEROCOPY) //        
+                    d_zeroCopy.push_back(std::make_pair(zeroCopyNext++, buffer));
+                sendSize += tempSize;
+                result = (part.size == sendSize) ? 0 : int(sendSize);
+                if (nonBlock)
+                    break; //   Send,      
+            }
+            else if (tempSize < 0)
+            {
+#ifndef __WIN32__
+                if ((flags & MSG_ZEROCOPY) && GetError() == ENOBUFS)
+                { //       -       
+                    ReapZeroCopy();
+                    flags &= ~MSG_ZEROCOPY;
+                    continue;
+                }
+#endif
+                if (nonBlock && GetError() == error_t::NON_BLOCK_SOCKET_NOT_READY)
+                    result = sendSize ? int(sendSize) : -3;
+                else
+                {
+                    logger.doLog("TCP_socketClient_t::SendZeroCopy() fail, errno: ", GetError());
+                    result = -1; //  
+                    b_connected = false; //   
+                }
+                break;
+            }
+            else
+                break;
+        }
+    }
+
+    return result;
+}
+
+/// <summary>
+///               
+/// </summary>
+/// <returns> N>=0 -  N ; -1 -   </returns>
+int network::TCP_socketClient_t::ReapZeroCopy()
+{
+    int result = 0;
+#ifndef __WIN32__
+    while (!d_zeroCopy.empty())
+    {
+        char control[128]; //     
+        msghdr msg;
+        memset(&msg, 0, sizeof(msg));
+        msg.msg_control = control;
+        msg.msg_controllen = sizeof(control);
+        //      
+        if (recvmsg(Socket, &msg, MSG_ERRQUEUE) < 0)
+        {
+            if (GetError() != EAGAIN && GetError() != EWOULDBLOCK)
+            {
+                logger.doLog("TCP_socketClient_t::ReapZeroCopy() fail, errno: ", GetError());
+                result = -1;
+            }
+            break;
+        }
+
+        for (cmsghdr* cmsg = CMSG_FIRSTHDR(&msg); cmsg != nullptr; cmsg = CMSG_NXTHDR(&msg, cmsg))
+            if ((cmsg->cmsg_level == SOL_IP && cmsg->cmsg_type == IP_RECVERR) || (cmsg->cmsg_level == SOL_IPV6 && cmsg->cmsg_type == IPV6_RECVERR))
+            {
+                sock_extended_err error;
+                memcpy(&error, CMSG_DATA(cmsg), sizeof(error));
+                if (error.ee_errno != 0 || error.ee_origin != SO_EE_ORIGIN_ZEROCOPY)
+                    continue;
+                //     [ee_info, ee_data];  
+                while (!d_zeroCopy.empty() && int(error.ee_data - d_zeroCopy.front().first) >= 0)
+                {
+                    d_zeroCopy.pop_front();
+                    ++result;
+                }
+                if (error.ee_code & SO_EE_CODE_ZEROCOPY_COPIED)
+                { //      (, loopback) -     
+                    DEBUG_TRACE(logger, "TCP_socketClient_t - zerocopy send was copied")
+                }
+            }
+    }
+#endif
+    return result;
+}
+
+/// <summary>
+///      ,    
+/// </summary>
+/// <returns>      </returns>
+size_t network::TCP_socketClient_t::GetZeroCopyPending() const
+{
+    return d_zeroCopy.size();
+}
+
+/// <summary>
+///      
+/// </summary>
+/// <returns> 1 -   </returns>
+bool network::TCP_socketClient_t::Connected()
+{
+    //   
+    if (CheckValidSocket(false) && !b_connected)
+    {   //      -   TCP -      SYN
+        if (0 != connect(Socket, serverInfo.getSockAddr(), serverInfo.SizeAddr()))
+            logger.doLog("TCP_socketClient_t non connected with server:", GetError());
+        else
+        {   //    ,     (  )
+            b_connected = true;
+            UpdateSockInfo();
+        }
+    }
+
+    return b_connected;
+}
+/// <summary>
+///    
+/// </summary>
+/// <returns> 1 -   </returns>
+bool network::TCP_socketClient_t::GetConnected() const
+{
+    return b_connected;
+}
+
+/// <summary>
+///   3- 
+/// </summary>
+/// <param name="ip"> - IP    "..." </param>
+/// <param name="port"> -   </param>
+/// <param name="logger"> -   </param>
+network::TCP_socketServer_t::TCP_socketServer_t(std::string ip, unsigned short port, log_t& logger) : socket_t(GetFamily(ip), SOCK_STREAM, 0, ip, port, logger),
+    b_listening(false)
+{ // listen    ,      
+    if (CheckValidSocket(false))
+    {
+        if (0 != listen(Socket, SOMAXCONN))
+            this->logger.doLog("TCP_socketServer_t listen fali ", GetError());
+        else
+            b_listening = true;
+    }
+}
+
+/// <summary>
+///   2- 
+/// </summary>
+/// <param name="sockInfo"> -    </param>
+/// <param name="logger"> -   </param>
+network::TCP_socketServer_t::TCP_socketServer_t(sockInfo_t sockInfo, log_t& logger) : socket_t(sockInfo.GetFamily(), SOCK_STREAM, 0, sockInfo, logger),
+    b_listening(false)
+{
+    if (CheckValidSocket(false))
+    {
+        if (0 != listen(Socket, SOMAXCONN))
+            this->logger.doLog("TCP_socketServer_t listen fali ", GetError());
+        else
+            b_listening = true;
+    }
+}
+
+/// <summary>
+///   4- ,        (    )
+/// </summary>
+/// <param name="ip"> - IP    "..." </param>
+/// <param name="port"> -   </param>
+/// <param name="reusePort"> - 1 -        (SO_REUSEPORT),  
+///      </param>
+/// <param name="logger"> -   </param>
+network::TCP_socketServer_t::TCP_socketServer_t(std::string ip, unsigned short port, bool reusePort, log_t& logger) : socket_t(GetFamily(ip), SOCK_STREAM, 0, logger),
+    b_listening(false)
+{ //     bind,    ,     
+    if (CheckValidSocket(false))
+    {
+        if (reusePort && !RAII_OSsock::setSocketOpt(Socket, RAII_OSsock::option_t::REUSE_PORT, this->logger))
+            this->logger.doLog("TCP_socketServer_t - port sharing not set, socket not bound"); //       
+        else if (Bind(ip, port))
+        {
+            if (0 != listen(Socket, SOMAXCONN))
+                this->logger.doLog("TCP_socketServer_t listen fali ", GetError());
+            else
+                b_listening = true;
+        }
+    }
+}
+
+/// <summary>
+///    
+/// </summary>
+/// <returns> 1 -  ; 0 - ,      (  ) </returns>
+bool network::TCP_socketServer_t::GetListening() const
+{
+    return b_listening;
+}
+
+/// <summary>
+///         
+/// </summary>
+/// <returns> 1 -       SO_REUSEPORT </returns>
+bool network::TCP_socketServer_t::ReusePortSupported()
+{
+#if !defined(__WIN32__) && defined(SO_REUSEPORT)
+    return true;
+#else
+    return false;
+#endif
+}
+
+/// <summary>
+///    
+/// </summary>
+/// <param name="client"> -         </param>
+/// <returns> 0 -   ,
+///          -1 -  ,
+///          -2 -       ( )</returns>
+///			 -3 -   ( )    
+int network::TCP_socketServer_t::AddClient(TCP_socketClient_t& client)
+{
+    int result = -1;
+
+    if (!client.CheckValidSocket(false) && CheckValidSocket(false))
+    {
+        sockInfo_t tempInfo(logger); //    
+        socklen_t sizeAddr = sizeof(sockaddr_storage); //  
+        //       .         .
+        //     ,   accept   -,  
+        //     .
+        SOCKET tempSocket = accept(Socket, tempInfo.setSockAddr(), &sizeAddr);
+        if (tempSocket != INVALID_SOCKET)
+        { //     ,   
+            tempInfo.UpdateSockInfo(); //    
+            if (client.SetSocket(tempSocket, tempInfo))
+            { //  ?    
+                DEBUG_TRACE(logger, "addClient success" + tempInfo.GetIP() + std::to_string(tempInfo.GetPort()))
+                    result = 0;
+            }
+            else //     
+                logger.doLog("fail SetSocket in addClient", GetError());
+        } //                     
+        else if (GetError() == error_t::NON_BLOCK_SOCKET_NOT_READY && nonBlock)
+            result = -2;
+        else
+            logger.doLog("accept fail", GetError()); //    
+    }
+    else
+        result = -3;
+
+    return result;
+}
+
+/// <summary>
+///     ()  
+/// </summary>
+/// <param name="source"> -     -        </param>
+void network::UDP_socket_t::Move(UDP_socket_t& source)
+{
+    if (Close() && socket_t::SetSocket(source.Socket, source.nonBlock))
+    {
+        lastCommunicationSocket.setSockInfo(source.lastCommunicationSocket);
+        u32_MTU = source.u32_MTU;
+        u32_segment = source.u32_segment; //      
+        b_segmentation = source.b_segmentation;
+        batchError = source.batchError;
+        source.b_segmentation = false;
+        source.batchError = 0;
+        source.Socket = INVALID_SOCKET;
+        source.af = AF_UNSPEC;
+        source.nonBlock = false;
+        source.lastCommunicationSocket.ResetSockInfo();
+        source.ResetSockInfo();
+    }
+}
+
+/// <summary>
+///   MTU   
+/// </summary>
+void network::UDP_socket_t::setMTU()
+{
+    b_segmentation = false;
+    batchError = 0; //    -    
+    // MTU  (IP_MTU)      ,        
+    //   -     MTU Ethernet,       SetSegmentation
+    //  IPv6        IPv4,       IPv6
+    unsigned int header = (af == AF_INET6) ? 40 : 20;
+    u32_segment = 1500 - header - 8; // Ethernet MTU   IP  UDP
+#ifdef __WIN32__
+    socklen_t optlen = sizeof(u32_MTU); //  
+    // getsockopt      ,     ,   
+    if (getsockopt(Socket, SOL_SOCKET, SO_MAX_MSG_SIZE, (char*)(&u32_MTU), &optlen))
+        logger.doLog("getsockopt fail ", GetError());
+#else
+    u32_MTU = 65507; //  SO_MAX_MSG_SIZE ,    UDP  IPv4 (   IPv6)
+#endif
+    if (u32_segment > u32_MTU)
+        u32_segment = u32_MTU;
+}
+
+/// <summary>
+///   1 
+/// </summary>
+/// <param name="logger"> -    </param>
+network::UDP_socket_t::UDP_socket_t(log_t& logger) : socket_t(AF_INET, SOCK_DGRAM, 0, logger), lastCommunicationSocket(logger)
+{
+    setMTU();
+}
+
+/// <summary>
+///   2 ,     
+/// </summary>
+/// <param name="af"> -  : AF_INET  AF_INET6 ( ,     IPv4) </param>
+/// <param name="logger"> -    </param>
+network::UDP_socket_t::UDP_socket_t(int af, log_t& logger) : socket_t(af, SOCK_DGRAM, 0, logger), lastCommunicationSocket(logger)
+{
+    if (af == AF_INET6 && CheckValidSocket(false)) //  bind    
+        setSocketOpt(Socket, option_t::DUAL_STACK, this->logger);
+    setMTU();
+}
+
+/// <summary>
+///   3- 
+/// </summary>
+/// <param name="ip"> - IP    "..." </param>
+/// <param name="port"> -   </param>
+/// <param name="logger"> -   </param>
+network::UDP_socket_t::UDP_socket_t(std::string ip, unsigned short port, log_t& logger) : socket_t(GetFamily(ip), SOCK_DGRAM, 0, ip, port, logger), lastCommunicationSocket(logger)
+{
+    setMTU();
+}
+
+/// <summary>
+///   2- 
+/// </summary>
+/// <param name="sockInfo"> -    </param>
+/// <param name="logger"> -   </param>
+network::UDP_socket_t::UDP_socket_t(sockInfo_t& sockInfo, log_t& logger) : socket_t(sockInfo.GetFamily(), SOCK_DGRAM, 0, sockInfo, logger), lastCommunicationSocket(logger)
+{
+    setMTU();
+}
+
+/// <summary>
+///        
+/// </summary>
+/// <param name="buffer"> -      </param>
+/// <param name="target"> -     </param>
+/// <returns> 0 -   ;
+///         N>0 -  N ;
+///          -1 -  ;
+///          -2 -    MTU    
+///          -3 -      ( ) </returns>
+int network::UDP_socket_t::SendTo(const std::string& buffer, const sockInfo_t& target)
+{
+    int result = -1;
+    //   ,           SEGMENTS_MAX 
+    if (CheckValidSocket(false) && buffer.size() < MTU() && (!b_segmentation || buffer.size() <= size_t(u32_segment) * SEGMENTS_MAX))
+    { //  sendto      
+        int sendSize = 0;
+        if (af == AF_INET6 && target.Addr.ss_family == AF_INET)
+        { //      IPv4    ::ffff:a.b.c.d
+            sockaddr_storage AddrIP = target.Addr;
+            socklen_t sizeAddr = MapAddr(AddrIP, af);
+            sendSize = sendto(Socket, buffer.c_str(), buffer.size(), 0, reinterpret_cast<const sockaddr*>(&AddrIP), sizeAddr);
+        }
+        else
+            sendSize = sendto(Socket, buffer.c_str(), buffer.size(), 0, target.getSockAddr(), target.SizeAddr());
+        //  
+        if (sendSize > 0)
+        { //    
+            result = (sendSize == buffer.size()) ? 0 : sendSize; //    ,  0 -  ,  ,    
+            DEBUG_TRACE(logger, "sendto: " + buffer)
+        }
+        else if (sendSize < 0)
+        { //   , ,        
+            if (GetError() == error_t::NON_BLOCK_SOCKET_NOT_READY && nonBlock)
+                result = -3; //    ()
+            else
+                logger.doLog("sendto fail ", GetError()); //   
+        }
+        else if (buffer.empty()) //    ?     
+            result = 0;
+    }
+    else
+        result = -2; //    MTU    
+
+    //     ,     (   )
+    if (target != lastCommunicationSocket)
+        lastCommunicationSocket.setSockInfo(target);
+
+    return result;
+}
+
+/// <summary>
+///        ,       
+/// </summary>
+/// <param name="buffer"> -      </param>
+/// <returns> 0 -   ;
+///         N>0 -  N ;
+///          -1 -  ;
+///          -2 -    MTU    
+///          -3 -      ( ) </returns>
+int network::UDP_socket_t::SendTo(const std::string& buffer)
+{
+    return SendTo(buffer, lastCommunicationSocket); //       
+}
+
+/// <summary>
+///        
+/// </summary>
+/// <param name="buffer"> -      </param>
+/// <param name="ip"> - IP    "..." </param>
+/// <param name="port"> -   </param>
+/// <returns> 0 -   ;
+///         N>0 -  N ;
+///          -1 -  ;
+///          -2 -    MTU    
+///          -3 -      ( ) </returns>
+int network::UDP_socket_t::SendTo(const std::string& buffer, std::string ip, unsigned short port)
+{
+    if (lastCommunicationSocket.setSockInfo(ip, port)) //    ,   
+        return SendTo(buffer); // 
+    else return -1;
+}
+
+/// <summary>
+///        
+/// </summary>
+/// <param name="buffer"> -     </param>
+/// <param name="str_EndOfMessege"> -    () </param>
+/// <param name="sizeMsg"> -    () </param>
+/// <returns>   0 -    ;
+///             N>0 -  N-;
+///             -1 -  ;
+///             -2 -      ;
+///             -3 -    ();</returns>
+int network::UDP_socket_t::RecvFrom(std::string& buffer, const std::string str_EndOfMessege, const size_t sizeMsg)
+{
+    int result = -1;
+
+    if (CheckValidSocket(false))
+    {
+        buffer.resize(2048); //    ,     
+        socklen_t SizeAddr = sizeof(sockaddr_storage); //   Addr
+        //  recvfrom      
+        int recvSize = recvfrom(Socket, &buffer[0], buffer.size(), 0, lastCommunicationSocket.setSockAddr(), &SizeAddr);
+        buffer.resize(recvSize > 0 ? recvSize : 0); //   , '\0'   
+
+        if (recvSize > 0)
+        { //   
+            DEBUG_TRACE(logger, "recvfrom: " + buffer)
+
+                bool EOM = str_EndOfMessege.empty() && (sizeMsg == 0);// EndOfMessege   
+            if (!str_EndOfMessege.empty() && buffer.size() >= str_EndOfMessege.size())
+            { //   EOM -    
+                EOM = buffer.compare(buffer.size() - str_EndOfMessege.size(), str_EndOfMessege.size(), str_EndOfMessege) == 0;
+            }
+            if (sizeMsg != 0) //    
+                EOM |= (buffer.size() >= sizeMsg); // ,      
+
+            result = EOM ? 0 : recvSize; //   ,  0,  -  
+
+            lastCommunicationSocket.UpdateSockInfo(); //    setSockAddr()
+        }
+        else if (recvSize < 0)
+        { //   ,         
+            if (GetError() == error_t::NON_BLOCK_SOCKET_NOT_READY && nonBlock)
+                result = -3;
+            else
+                logger.doLog("recfrom fail ", GetError());
+        }
+        else
+            result = -2; //  
+    }
+    else
+        result = -2;
+
+    return result;
+}
+
+/// <summary>
+///        ,    (  )
+/// </summary>
+/// <param name="buffer"> -    ,      </param>
+/// <returns>   N>0 -  N-;
+///             -1 -  ;
+///             -2 -      ;
+///             -3 -    ();</returns>
+int network::UDP_socket_t::RecvFrom(slice_t buffer)
+{
+    int result = -2;
+
+    if (CheckValidSocket(false) && buffer.size != 0)
+    {
+        socklen_t SizeAddr = sizeof(sockaddr_storage); //   Addr
+        //  recvfrom      
+        result = recvfrom(Socket, buffer.data, int(buffer.size), 0, lastCommunicationSocket.setSockAddr(), &SizeAddr);
+
+        if (result > 0)
+        {
+            DEBUG_TRACE(logger, "recvfrom: " + std::string(buffer.data, result))
+            lastCommunicationSocket.UpdateSockInfo(); //    setSockAddr()
+        }
+        else if (result < 0)
+        { //   ,         
+            if (GetError() == error_t::NON_BLOCK_SOCKET_NOT_READY && nonBlock)
+                result = -3;
+            else
+            {
+                logger.doLog("recfrom fail ", GetError());
+                result = -1;
+            }
+        }
+        else
+            result = -2; //  
+    }
+
+    return result;
+}
+
+/// <summary>
+///         
+/// </summary>
+/// <param name="buffer"> -  ,      </param>
+/// <param name="minSize"> -       </param>
+/// <returns>   N>0 -  N-;
+///             -1 -  ;
+///             -2 -      ;
+///             -3 -    ();</returns>
+int network::UDP_socket_t::RecvFrom(buffer_t& buffer, size_t minSize)
+{
+    int result = RecvFrom(buffer.WriteSlice(minSize));
+    if (result > 0)
+        buffer.Commit(result);
+    return result;
+}
+
+/// <summary>
+///           (/ )
+/// </summary>
+/// <returns>       (/ ) </returns>
+network::sockInfo_t network::UDP_socket_t::GetLastCommunication() const
+{
+    return lastCommunicationSocket;
+}
+
+/// <summary>
+///   MTU
+/// </summary>
+/// <returns>    </returns>
+unsigned int network::UDP_socket_t::MTU() const
+{
+    return u32_MTU;
+}
+
+/// <summary>
+///    
+/// </summary>
+/// <returns>         </returns>
+unsigned int network::UDP_socket_t::SegmentSize() const
+{
+    return u32_segment;
+}
+
+/// <summary>
+///     (Linux - UDP_SEGMENT/UDP_GRO)
+/// </summary>
+/// <param name="enable"> - 1 - ; 0 -  </param>
+/// <param name="segmentSize"> -  , 0 -   MTU Ethernet (. SegmentSize) </param>
+/// <returns> 1 -   </returns>
+bool network::UDP_socket_t::SetSegmentation(bool enable, unsigned int segmentSize)
+{
+    bool result = false;
+
+    if (segmentSize == 0)
+        segmentSize = u32_segment;
+
+    if (CheckValidSocket(false) && segmentSize != 0 && segmentSize < MTU())
+    {
+#ifdef __WIN32__
+        logger.doLog("UDP_socket_t - UDP segmentation not supported");
+#else
+        int segment = enable ? int(segmentSize) : 0; // 0 -    
+        int gro = enable ? 1 : 0;
+        //  UDP_SEGMENT       , UDP_GRO    
+        if (setsockopt(Socket, IPPROTO_UDP, UDP_SEGMENT, &segment, sizeof(segment)))
+            logger.doLog("setsockopt UDP_SEGMENT fail ", GetError());
+        else if (setsockopt(Socket, IPPROTO_UDP, UDP_GRO, &gro, sizeof(gro)))
+        {
+            logger.doLog("setsockopt UDP_GRO fail ", GetError());
+            segment = 0;
+            setsockopt(Socket, IPPROTO_UDP, UDP_SEGMENT, &segment, sizeof(segment)); // ,   
+        }
+        else
+        {
+            b_segmentation = enable;
+            u32_segment = segmentSize;
+            result = true;
+        }
+#endif
+    }
+
+    return result;
+}
+
+/// <summary>
+///      ( ).      
+/// </summary>
+/// <param name="buffer"> -    ,      64  </param>
+/// <param name="segmentSize"> -  :   -   segmentSize ,     </param>
+/// <returns>   N>0 -  N-;
+///             -1 -  ;
+///             -2 -      ;
+///             -3 -    ();</returns>
+int network::UDP_socket_t::RecvSegments(slice_t buffer, unsigned int& segmentSize)
+{
+#ifdef __WIN32__
+    int result = RecvFrom(buffer); //   -  
+    segmentSize = result > 0 ? result : 0;
+#else
+    int result = -2;
+    segmentSize = 0;
+
+    if (CheckValidSocket(false) && buffer.size != 0)
+    {
+        iovec iov; //  
+        iov.iov_base = buffer.data;
+        iov.iov_len = buffer.size;
+        char control[CMSG_SPACE(sizeof(int))]; //  :    
+        msghdr msg;
+        memset(&msg, 0, sizeof(msg));
+        msg.msg_name = lastCommunicationSocket.setSockAddr();
+        msg.msg_namelen = sizeof(sockaddr_storage);
+        msg.msg_iov = &iov;
+        msg.msg_iovlen = 1;
+        msg.msg_control = control;
+        msg.msg_controllen = sizeof(control);
+
+        result = recvmsg(Socket, &msg, 0);
+        if (result > 0)
+        {
+            segmentSize = result; //      
+            for (cmsghdr* cmsg = CMSG_FIRSTHDR(&msg); cmsg != nullptr; cmsg = CMSG_NXTHDR(&msg, cmsg))
+                if (cmsg->cmsg_level == IPPROTO_UDP && cmsg->cmsg_type == UDP_GRO)
+                {
+                    int gso = 0;
+                    memcpy(&gso, CMSG_DATA(cmsg), sizeof(gso));
+                    if (gso > 0)
+                        segmentSize = gso;
+                }
+            lastCommunicationSocket.UpdateSockInfo(); //    setSockAddr()
+        }
+        else if (result < 0)
+        { //   ,         
+            if (GetError() == error_t::NON_BLOCK_SOCKET_NOT_READY && nonBlock)
+                result = -3;
+            else
+            {
+                logger.doLog("recvmsg fail ", GetError());
+                result = -1;
+            }
+        }
+        else
+            result = -2; //  
+    }
+#endif
+
+    return result;
+}
+
+/// <summary>
+///         (Linux - recvmmsg).    
+///        ,     
+/// </summary>
+/// <param name="batch"> - ,    </param>
+/// <returns>   N>0 -  N ;
+///             -1 -  ;
+///             -2 -   ;
+///             -3 -    ();</returns>
+int network::UDP_socket_t::RecvBatch(datagramBatch_t& batch)
+{
+    int result = -2;
+    batch.count = 0;
+
+    if (CheckValidSocket(false))
+    {
+#ifdef __WIN32__
+        //    -   ,      
+        result = 0;
+        u_long pending = 1; //     
+        while (result < int(batch.CAPACITY) && pending != 0)
+        {
+            batch.v_peerLen[result] = sizeof(sockaddr_storage);
+            int recvSize = recvfrom(Socket, &batch.p_data[result * batch.SIZE], int(batch.SIZE), 0, (sockaddr*)&batch.v_peer[result], &batch.v_peerLen[result]);
+            //    -    ,   
+            batch.v_truncated[result] = (recvSize < 0 && GetError() == error_t::DATAGRAM_TRUNCATED);
+            if (batch.v_truncated[result])
+                recvSize = int(batch.SIZE);
+            if (recvSize < 0)
+            {
+                if (result == 0)
+                { //     -   
+                    if (GetError() == error_t::NON_BLOCK_SOCKET_NOT_READY && nonBlock)
+                        result = -3;
+                    else
+                    {
+                        logger.doLog("recfrom fail ", GetError());
+                        result = -1;
+                    }
+                }
+                break; //   ,   
+            }
+            batch.v_size[result++] = recvSize;
+            if (ioctlsocket(Socket, FIONREAD, &pending))
+                pending = 0;
+        }
+#else
+        for (size_t index = 0; index < batch.CAPACITY; ++index)
+        { //     -    
+            batch.v_iov[index].iov_len = batch.SIZE;
+            batch.v_msg[index].msg_hdr.msg_namelen = sizeof(sockaddr_storage);
+        }
+        //    recvmmsg   
+        result = recvmmsg(Socket, &batch.v_msg[0], unsigned(batch.CAPACITY), MSG_WAITFORONE, nullptr);
+        if (result > 0)
+        {
+            for (int index = 0; index < result; ++index)
+            {
+                batch.v_size[index] = batch.v_msg[index].msg_len;
+                batch.v_truncated[index] = (batch.v_msg[index].msg_hdr.msg_flags & MSG_TRUNC) != 0;
+                batch.v_peerLen[index] = batch.v_msg[index].msg_hdr.msg_namelen;
+            }
+        }
+        else if (result < 0)
+        {
+            if (GetError() == error_t::NON_BLOCK_SOCKET_NOT_READY && nonBlock)
+                result = -3;
+            else
+            {
+                logger.doLog("recvmmsg fail ", GetError());
+                result = -1;
+            }
+        }
+        else
+            result = -2;
+#endif
+        if (result > 0)
+            batch.count = result;
+    }
+
+    return result;
+}
+
 /// <summary>
-///   1 
+///         (Linux - sendmmsg)
 /// </summary>
-/// <param name="logger"> -    </param>
-network::UDP_socket_t::UDP_socket_t(log_t& logger) : socket_t(AF_INET, SOCK_DGRAM, 0, logger), lastCommunicationSocket(logger)
+/// <param name="batch"> - ,   Add </param>
+/// <returns>   N>=0 -  N    (   Count);
+///             -1 -   (      );
+///             -2 -   ;
+///             -3 -    ();</returns>
+int network::UDP_socket_t::SendBatch(datagramBatch_t& batch)
 {
-    setMTU();
+    int result = -2;
+
+    if (batchError != 0)
+    { //         -    
+        logger.doLog("SendBatch fail ", batchError);
+        batchError = 0;
+        result = -1;
+    }
+    else if (CheckValidSocket(false))
+    {
+        if (af == AF_INET6) //   :  IPv4    ::ffff:a.b.c.d
+            for (size_t index = 0; index < batch.count; ++index)
+                if (batch.v_peer[index].ss_family == AF_INET)
+                {
+                    batch.v_peerLen[index] = MapAddr(batch.v_peer[index], af);
+#ifndef __WIN32__
+                    batch.v_msg[index].msg_hdr.msg_namelen = batch.v_peerLen[index];
+#endif
+                }
+
+        result = 0;
+        while (size_t(result) < batch.count)
+        {
+#ifdef __WIN32__
+            //    -   
+            int sendSize = sendto(Socket, &batch.p_data[result * batch.SIZE], int(batch.v_size[result]), 0, (const sockaddr*)&batch.v_peer[result], batch.v_peerLen[result]);
+            int sent = sendSize < 0 ? -1 : 1;
+#else
+            for (size_t index = result; index < batch.count; ++index)
+                batch.v_iov[index].iov_len = batch.v_size[index];
+            // sendmmsg     -  
+            int sent = sendmmsg(Socket, &batch.v_msg[result], unsigned(batch.count - result), 0);
+#endif
+            if (sent < 0)
+            {
+                if (GetError() == error_t::NON_BLOCK_SOCKET_NOT_READY && nonBlock)
+                {
+                    if (result == 0)
+                        result = -3;
+                }
+                else if (result > 0)
+                    batchError = GetError(); //    -    
+                else
+                {
+                    logger.doLog("SendBatch fail ", GetError());
+                    result = -1;
+                }
+                break;
+            }
+            result += sent; //   ,    
+        }
+    }
+
+    return result;
 }
 
 /// <summary>
-///   3- 
+/// 
 /// </summary>
-/// <param name="ip"> - IP    "..." </param>
-/// <param name="port"> -   </param>
-/// <param name="logger"> -   </param>
-network::UDP_socket_t::UDP_socket_t(std::string ip, unsigned short port, log_t& logger) : socket_t(AF_INET, SOCK_DGRAM, 0, ip, port, logger), lastCommunicationSocket(logger)
+/// <param name="capacity"> -      </param>
+/// <param name="size"> -     </param>
+network::datagramBatch_t::datagramBatch_t(size_t capacity, size_t size) :
+    CAPACITY(capacity ? capacity : 1), SIZE(size ? size : 1), count(0), p_data(new char[CAPACITY * SIZE]),
+    v_size(CAPACITY, 0), v_truncated(CAPACITY, false), v_peer(CAPACITY), v_peerLen(CAPACITY, 0)
 {
-    setMTU();
+    memset(&v_peer[0], 0, CAPACITY * sizeof(sockaddr_storage));
+#ifndef __WIN32__
+    //       ,      
+    v_iov.resize(CAPACITY);
+    v_msg.resize(CAPACITY);
+    memset(&v_msg[0], 0, CAPACITY * sizeof(mmsghdr));
+    for (size_t index = 0; index < CAPACITY; ++index)
+    {
+        v_iov[index].iov_base = &p_data[index * SIZE];
+        v_iov[index].iov_len = SIZE;
+        v_msg[index].msg_hdr.msg_iov = &v_iov[index];
+        v_msg[index].msg_hdr.msg_iovlen = 1;
+        v_msg[index].msg_hdr.msg_name = &v_peer[index];
+        v_msg[index].msg_hdr.msg_namelen = sizeof(sockaddr_storage);
+    }
+#endif
 }
 
 /// <summary>
-///   2- 
+///       
 /// </summary>
-/// <param name="sockInfo"> -    </param>
-/// <param name="logger"> -   </param>
-network::UDP_socket_t::UDP_socket_t(sockInfo_t& sockInfo, log_t& logger) : socket_t(AF_INET, SOCK_DGRAM, 0, sockInfo, logger), lastCommunicationSocket(logger)
+void network::datagramBatch_t::Clear()
 {
-    setMTU();
+    count = 0;
 }
 
 /// <summary>
-///        
+///     
 /// </summary>
-/// <param name="buffer"> -      </param>
-/// <param name="target"> -     </param>
-/// <returns> 0 -   ;
-///         N>0 -  N ;
-///          -1 -  ;
-///          -2 -    MTU    
-///          -3 -      ( ) </returns>
-int network::UDP_socket_t::SendTo(const std::string& buffer, sockInfo_t target)
+/// <param name="data"> -  </param>
+/// <param name="size"> -  ,      </param>
+/// <param name="target"> -  </param>
+/// <returns> 1 - ; 0 -       </returns>
+bool network::datagramBatch_t::Add(const char* data, size_t size, const sockInfo_t& target)
 {
-    int result = -1;
-    //   
-    if (CheckValidSocket(false) && buffer.size() < MTU())
-    { //  sendto      
-        int sendSize = sendto(Socket, buffer.c_str(), buffer.size(), 0, target.getSockAddr(), target.SizeAddr());
-        //  
-        if (sendSize > 0)
-        { //    
-            result = (sendSize == buffer.size()) ? 0 : sendSize; //    ,  0 -  ,  ,    
-            DEBUG_TRACE(logger, "sendto: " + buffer)
-        }
-        else if (sendSize < 0)
-        { //   , ,        
-            if (GetError() == error_t::NON_BLOCK_SOCKET_NOT_READY && nonBlock)
-                result = -3; //    ()
-            else
-                logger.doLog("sendto fail ", GetError()); //   
-        }
-        else if (buffer.empty()) //    ?     
-            result = 0;
-    }
-    else
-        result = -2; //    MTU    
+    bool result = false;
 
-    //     ,     (   )
-    if (target != lastCommunicationSocket)
-        lastCommunicationSocket.setSockInfo(target);
+    result = (count < CAPACITY && size <= SIZE && target.SizeAddr() <= sizeof(sockaddr_storage));
+    if (result)
+    {
+        memcpy(&p_data[count * SIZE], data, size);
+        v_size[count] = size;
+        v_truncated[count] = false;
+        memcpy(&v_peer[count], target.getSockAddr(), target.SizeAddr());
+        v_peerLen[count] = socklen_t(target.SizeAddr());
+#ifndef __WIN32__
+        v_msg[count].msg_hdr.msg_namelen = v_peerLen[count];
+#endif
+        ++count;
+    }
 
     return result;
 }
 
 /// <summary>
-///        ,       
+///      
 /// </summary>
-/// <param name="buffer"> -      </param>
-/// <returns> 0 -   ;
-///         N>0 -  N ;
-///          -1 -  ;
-///          -2 -    MTU    
-///          -3 -      ( ) </returns>
-int network::UDP_socket_t::SendTo(const std::string& buffer)
+/// <returns>   </returns>
+size_t network::datagramBatch_t::Count() const
 {
-    return SendTo(buffer, lastCommunicationSocket); //       
+    return count;
 }
 
 /// <summary>
-///        
+///    
 /// </summary>
-/// <param name="buffer"> -      </param>
-/// <param name="ip"> - IP    "..." </param>
-/// <param name="port"> -   </param>
-/// <returns> 0 -   ;
-///         N>0 -  N ;
-///          -1 -  ;
-///          -2 -    MTU    
-///          -3 -      ( ) </returns>
-int network::UDP_socket_t::SendTo(const std::string& buffer, std::string ip, unsigned short port)
+/// <returns>    </returns>
+size_t network::datagramBatch_t::Capacity() const
 {
-    if (lastCommunicationSocket.setSockInfo(ip, port)) //    ,   
-        return SendTo(buffer); // 
-    else return -1;
+    return CAPACITY;
 }
 
 /// <summary>
-///        
+///    
 /// </summary>
-/// <param name="buffer"> -     </param>
-/// <param name="str_EndOfMessege"> -    () </param>
-/// <param name="sizeMsg"> -    () </param>
-/// <returns>   0 -    ;
-///             N>0 -  N-;
-///             -1 -  ;
-///             -2 -      ;
-///             -3 -    ();</returns>
-int network::UDP_socket_t::RecvFrom(std::string& buffer, const std::string str_EndOfMessege, const size_t sizeMsg)
+/// <param name="index"> -   </param>
+/// <returns>  ,       </returns>
+network::slice_t network::datagramBatch_t::Data(size_t index) const
 {
-    int result = -1;
-
-    if (CheckValidSocket(false))
-    {
-        buffer.clear(); //  
-        std::string tempStr(2048, '\0'); //       
-        int SizeAddr = lastCommunicationSocket.SizeAddr(); //   Addr
-        //  recvfrom      
-        int recvSize = recvfrom(Socket, &tempStr[0], tempStr.size(), 0, lastCommunicationSocket.setSockAddr(), &SizeAddr);
-
-        if (recvSize > 0)
-        { //   
-            buffer.assign(tempStr.c_str()); //   '\0'   
-            DEBUG_TRACE(logger, "recvfrom: " + tempStr)
-
-                bool EOM = str_EndOfMessege.empty() && (sizeMsg == 0);// EndOfMessege   
-            if (!str_EndOfMessege.empty())
-            { //   EOM
-                int pos = buffer.size() - str_EndOfMessege.size(); //     
-                if (pos >= 0) //   
-                    EOM = (buffer.rfind(str_EndOfMessege) == pos); //     
-            }
-            if (sizeMsg != 0) //    
-                EOM |= (buffer.size() >= sizeMsg); // ,      
-
-            result = EOM ? 0 : recvSize; //   ,  0,  -  
+    return index < count ? slice_t(&p_data[index * SIZE], v_size[index]) : slice_t();
+}
 
-            lastCommunicationSocket.UpdateSockInfo(); //    setSockAddr()
-        }
-        else if (recvSize < 0)
-        { //   ,         
-            if (GetError() == error_t::NON_BLOCK_SOCKET_NOT_READY && nonBlock)
-                result = -3;
-            else
-                logger.doLog("recfrom fail ", GetError());
-        }
-        else
-            result = -2; //  
-    }
-    else
-        result = -2;
+/// <summary>
+///     
+/// </summary>
+/// <param name="index"> -   </param>
+/// <returns> 1 -   ,  Data   ; 0 -   </returns>
+bool network::datagramBatch_t::Truncated(size_t index) const
+{
+    return index < count && v_truncated[index];
+}
 
-    return result;
+/// <summary>
+///    /    
+/// </summary>
+/// <param name="index"> -   </param>
+/// <returns>   </returns>
+const sockaddr* network::datagramBatch_t::Peer(size_t index) const
+{
+    return index < count ? (const sockaddr*)&v_peer[index] : nullptr;
 }
 
 /// <summary>
-///           (/ )
+///   IP /  (   )
 /// </summary>
-/// <returns>       (/ ) </returns>
-network::sockInfo_t network::UDP_socket_t::GetLastCommunication() const
+/// <param name="index"> -   </param>
+/// <returns> IP    "..." </returns>
+std::string network::datagramBatch_t::PeerIP(size_t index) const
 {
-    return lastCommunicationSocket;
+    char bufIP[64];//    IP
+    const char* result = nullptr;
+
+    if (index < count)
+    {
+        if (v_peer[index].ss_family == AF_INET)
+            result = inet_ntop(AF_INET, &((const sockaddr_in*)&v_peer[index])->sin_addr, bufIP, sizeof(bufIP));
+        else if (v_peer[index].ss_family == AF_INET6)
+            result = inet_ntop(AF_INET6, &((const sockaddr_in6*)&v_peer[index])->sin6_addr, bufIP, sizeof(bufIP));
+    }
+
+    return result ? std::string(result) : std::string();
 }
 
 /// <summary>
-///   MTU
+///    / 
 /// </summary>
-/// <returns>    </returns>
-unsigned int network::UDP_socket_t::MTU() const
+/// <param name="index"> -   </param>
+/// <returns>   </returns>
+unsigned short network::datagramBatch_t::PeerPort(size_t index) const
 {
-    return u32_MTU;
+    unsigned short result = 0;
+
+    if (index < count)
+    {
+        if (v_peer[index].ss_family == AF_INET)
+            result = ntohs(((const sockaddr_in*)&v_peer[index])->sin_port);
+        else if (v_peer[index].ss_family == AF_INET6)
+            result = ntohs(((const sockaddr_in6*)&v_peer[index])->sin6_port);
+    }
+
+    return result;
 }
 
 /// <summary>
@@ -961,11 +2179,25 @@ bool network::NonBlockSocket_manager_t::addSocket(std::map<int, std::shared_ptr<
 
     if (socket->CheckValidSocket()) //  ?
         if (socket->setNonBlock()) //   
-            if (result = m_sock.find(socket->getSocket()) == m_sock.end()) //      
+        {
+            result = m_sock.find(socket->getSocket()) == m_sock.end();
+            if (result) //      
             {
                 m_sock[socket->getSocket()] = socket; //  
+#ifdef __WIN32__
                 b_change = true; //  ,   pollfd
+#else
+                result = UpdateEpoll(socket->getSocket()); //   epoll
+                if (!result)
+                    m_sock.erase(socket->getSocket()); //   - 
+#endif
+                if (result)
+                { //      ( ,      )
+                    Unlink(*socket);
+                    socket->v_manager.push_back(this);
+                }
             }
+        }
 
     return result;
 }
@@ -979,16 +2211,63 @@ bool network::NonBlockSocket_manager_t::deleteSocket(std::map<int, std::shared_p
 {
     bool result = false;
     //       ?   ,    ,      
-    if (result = m_sock.find(socket->getSocket()) != m_sock.end()) //      
+    result = m_sock.find(socket->getSocket()) != m_sock.end();
+    if (result) //      
     {
         m_sock.erase(socket->getSocket()); //  
+#ifdef __WIN32__
         b_change = true; //  ,   pollfd
+#else
+        UpdateEpoll(socket->getSocket()); //    
+#endif
+        int fd = int(socket->getSocket());
+        if (m_senderSocket.find(fd) == m_senderSocket.end() && m_readerSocket.find(fd) == m_readerSocket.end() &&
+            m_serverSocket.find(fd) == m_serverSocket.end() && m_clientSocket.find(fd) == m_clientSocket.end())
+            Unlink(*socket);
     }
 
     return result;
 }
 
+/// <summary>
+///      ,        
+/// </summary>
+/// <param name="socket"> -  </param>
+void network::NonBlockSocket_manager_t::Unlink(socket_t& socket)
+{
+    for (std::vector<NonBlockSocket_manager_t*>::iterator iter = socket.v_manager.begin(); iter != socket.v_manager.end(); ++iter)
+        if (*iter == this)
+        {
+            socket.v_manager.erase(iter);
+            break;
+        }
+}
+
+/// <summary>
+///        ( socket_t::Close  ).
+///  ,     ,        epoll
+/// </summary>
+/// <param name="fd"> -   </param>
+void network::NonBlockSocket_manager_t::Forget(int fd)
+{
+    std::map<int, std::shared_ptr<socket_t>>* lists[] = { &m_senderSocket, &m_readerSocket, &m_serverSocket, &m_clientSocket };
+    for (size_t index = 0; index < sizeof(lists) / sizeof(lists[0]); ++index)
+    {
+        std::map<int, std::shared_ptr<socket_t>>::iterator iter = lists[index]->find(fd);
+        if (iter != lists[index]->end())
+        {
+            v_closed.push_back(iter->second);
+            lists[index]->erase(iter);
+        }
+    }
+#ifdef __WIN32__
+    b_change = true; //  ,   pollfd
+#else
+    UpdateEpoll(fd); //    -    
+#endif
+}
 
+#ifdef __WIN32__
 /// <summary>
 ///    pollfd
 /// </summary>
@@ -1025,12 +2304,12 @@ void network::NonBlockSocket_manager_t::UpdatePollfd()
             }
             else if (iter_server != m_serverSocket.end())
             {
-                v_fds[indx].fd = iter_sender->second->getSocket();
+                v_fds[indx].fd = iter_server->second->getSocket();
                 v_fds[indx].events = POLLIN;
                 v_fds[indx].revents = 0;
                 ++iter_server;
             }
-            else if (iter_server != m_serverSocket.end())
+            else if (iter_client != m_clientSocket.end())
             {
                 v_fds[indx].fd = iter_client->second->getSocket();
                 v_fds[indx].events = POLLOUT;
@@ -1046,6 +2325,58 @@ void network::NonBlockSocket_manager_t::UpdatePollfd()
             v_fds[indx].revents = 0;
 
 }
+#else
+/// <summary>
+///      epoll,      
+/// </summary>
+/// <param name="fd"> -   </param>
+/// <returns> 1 -  epoll  </returns>
+bool network::NonBlockSocket_manager_t::UpdateEpoll(int fd)
+{
+    bool result = true;
+    //         ,  epoll     
+    unsigned mask = 0;
+    if (m_readerSocket.find(fd) != m_readerSocket.end() || m_serverSocket.find(fd) != m_serverSocket.end())
+        mask |= EPOLLIN;
+    if (m_senderSocket.find(fd) != m_senderSocket.end() || m_clientSocket.find(fd) != m_clientSocket.end())
+        mask |= EPOLLOUT;
+
+    std::map<int, unsigned>::iterator iter = m_epollMask.find(fd); //      
+    struct epoll_event event;
+    memset(&event, 0, sizeof(event));
+    event.events = mask | (edgeTriggered ? unsigned(EPOLLET) : 0u);
+    event.data.fd = fd;
+
+    if (mask == 0)
+    { //      -   
+        if (iter != m_epollMask.end())
+        {
+            m_epollMask.erase(iter);
+            if (epoll_ctl(epollFd, EPOLL_CTL_DEL, fd, &event) && GetError() != EBADF && GetError() != ENOENT) //   epoll  
+                logger.doLog("epoll_ctl DEL fail ", GetError());
+        }
+    }
+    else if (iter == m_epollMask.end())
+    { //  
+        result = (epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &event) == 0);
+        if (result)
+            m_epollMask[fd] = mask;
+        else
+            logger.doLog("epoll_ctl ADD fail ", GetError());
+    }
+    else if (iter->second != mask)
+    { //    
+        result = (epoll_ctl(epollFd, EPOLL_CTL_MOD, fd, &event) == 0);
+        if (result)
+            iter->second = mask;
+        else
+            logger.doLog("epoll_ctl MOD fail ", GetError());
+    }
+
+    return result;
+}
+#endif
+
 /// <summary>
 ///    
 /// </summary>
@@ -1056,7 +2387,10 @@ int network::NonBlockSocket_manager_t::Poll(int timeOut)
 #ifdef __WIN32__
     return WSAPoll(&v_fds[0], v_fds.size(), timeOut);// WSAPoll      revents  WSAPOLLFD
 #else
-    return poll(&v_fds[0], v_fds.size(), timeOut);
+    int result = epoll_wait(epollFd, &v_events[0], v_events.size(), timeOut); //    
+    if (result == -1 && GetError() == EINTR) //    
+        result = 0;
+    return result;
 #endif
 }
 
@@ -1064,16 +2398,41 @@ int network::NonBlockSocket_manager_t::Poll(int timeOut)
 ///    
 /// </summary>
 /// <param name="logger"> -    </param>
-network::NonBlockSocket_manager_t::NonBlockSocket_manager_t(log_t& logger) : RAII_OSsock(logger), b_change(false), logger(logger)
+network::NonBlockSocket_manager_t::NonBlockSocket_manager_t(log_t& logger) : NonBlockSocket_manager_t(0, logger)
 {}
 /// <summary>
-///    
+///    
 /// </summary>
 /// <param name="size"> -     </param>
 /// <param name="logger"> -    </param>
-network::NonBlockSocket_manager_t::NonBlockSocket_manager_t(int size, log_t& logger) : RAII_OSsock(logger), b_change(false), logger(logger)
+/// <param name="edgeTriggered"> -     ( epoll) </param>
+network::NonBlockSocket_manager_t::NonBlockSocket_manager_t(int size, log_t& logger, bool edgeTriggered) : RAII_OSsock(logger), b_change(false), logger(logger)
 {
+#ifdef __WIN32__
     v_fds.reserve(size);
+#else
+    this->edgeTriggered = edgeTriggered;
+    v_events.resize(size > 64 ? size : 64); //    epoll_wait    ,    
+    epollFd = epoll_create1(EPOLL_CLOEXEC);
+    if (epollFd == -1)
+        logger.doLog("epoll_create1 fail ", GetError());
+#endif
+}
+
+/// <summary>
+/// 
+/// </summary>
+network::NonBlockSocket_manager_t::~NonBlockSocket_manager_t()
+{
+    //    -       
+    std::map<int, std::shared_ptr<socket_t>>* lists[] = { &m_senderSocket, &m_readerSocket, &m_serverSocket, &m_clientSocket };
+    for (size_t index = 0; index < sizeof(lists) / sizeof(lists[0]); ++index)
+        for (std::map<int, std::shared_ptr<socket_t>>::iterator iter = lists[index]->begin(); iter != lists[index]->end(); ++iter)
+            Unlink(*iter->second);
+#ifndef __WIN32__
+    if (epollFd != -1)
+        close(epollFd);
+#endif
 }
 /// <summary>
 ///   
@@ -1199,11 +2558,15 @@ bool network::NonBlockSocket_manager_t::GetReadyClient(std::shared_ptr<socket_t>
 /// <param name="timeOut"> -    </param>
 /// <returns> 1 -     </returns>
 bool network::NonBlockSocket_manager_t::Work(const int timeOut)
-{//    
+{
+    v_closed.clear(); //          
+    //    
     m_readySender.clear();
     m_readyReader.clear();
     m_readyServer.clear();
     m_readyClient.clear();
+    m_readyError.clear();
+#ifdef __WIN32__
     //   pollfd
     UpdatePollfd();
     size_t size = v_fds.size();
@@ -1220,10 +2583,82 @@ bool network::NonBlockSocket_manager_t::Work(const int timeOut)
                 m_readyServer[v_fds[indx].fd] = m_serverSocket[v_fds[indx].fd];
             else if (v_fds[indx].revents & POLLOUT && m_clientSocket.find(v_fds[indx].fd) != m_clientSocket.end()) //    
                 m_readyClient[v_fds[indx].fd] = m_clientSocket[v_fds[indx].fd];
+        for (size_t indx = 0; indx < size; ++indx)
+            if (v_fds[indx].revents & POLLERR)
+            {
+                if (m_readerSocket.find(v_fds[indx].fd) != m_readerSocket.end())
+                    m_readyError[v_fds[indx].fd] = m_readerSocket[v_fds[indx].fd];
+                else if (m_senderSocket.find(v_fds[indx].fd) != m_senderSocket.end())
+                    m_readyError[v_fds[indx].fd] = m_senderSocket[v_fds[indx].fd];
+            }
     }
     else if (resPoll < 0) //  
         logger.doLog("poll error", GetError());
+#else
+    //   ,  epoll      
+    int resPoll = Poll(timeOut);
+    if (resPoll > 0) //   
+    {  //    
+        for (int indx = 0; indx < resPoll; ++indx)
+        {
+            int fd = v_events[indx].data.fd;
+            unsigned events = v_events[indx].events;
+            std::map<int, std::shared_ptr<socket_t>>::iterator iter;
+            //      ,        Recive/Send/AddClient
+            if (events & (EPOLLIN | EPOLLHUP | EPOLLERR))
+            {
+                if ((iter = m_readerSocket.find(fd)) != m_readerSocket.end()) //    
+                    m_readyReader[fd] = iter->second;
+                if ((iter = m_serverSocket.find(fd)) != m_serverSocket.end()) //    
+                    m_readyServer[fd] = iter->second;
+            }
+            if (events & (EPOLLOUT | EPOLLHUP | EPOLLERR))
+            {
+                if ((iter = m_senderSocket.find(fd)) != m_senderSocket.end()) //    
+                    m_readySender[fd] = iter->second;
+                if ((iter = m_clientSocket.find(fd)) != m_clientSocket.end()) //    
+                    m_readyClient[fd] = iter->second;
+            }
+            if (events & EPOLLERR)
+            { //      (    )
+                if ((iter = m_readerSocket.find(fd)) != m_readerSocket.end() || (iter = m_senderSocket.find(fd)) != m_senderSocket.end())
+                    m_readyError[fd] = iter->second;
+            }
+        }
+        if (resPoll == (int)v_events.size()) //    -     
+            v_events.resize(v_events.size() * 2);
+    }
+    else if (resPoll < 0) //  
+        logger.doLog("epoll_wait error", GetError());
+#endif
+
+    return !m_readySender.empty() || !m_readyReader.empty() || !m_readyServer.empty() || !m_readyClient.empty() || !m_readyError.empty(); //      ?
+}
+
+/// <summary>
+///         Work(),       GetReadyReader
+/// </summary>
+/// <returns>    -  </returns>
+const std::map<int, std::shared_ptr<network::socket_t>>& network::NonBlockSocket_manager_t::GetReadyReaders() const
+{
+    return m_readyReader;
+}
 
-    return !m_readySender.empty() || !m_readyReader.empty() || !m_readyServer.empty() || !m_readyClient.empty(); //      ?
+/// <summary>
+///         Work()
+/// </summary>
+/// <returns>    -  </returns>
+const std::map<int, std::shared_ptr<network::socket_t>>& network::NonBlockSocket_manager_t::GetReadySenders() const
+{
+    return m_readySender;
+}
+
+/// <summary>
+///     ,    Work()      
+/// </summary>
+/// <returns>    -  </returns>
+const std::map<int, std::shared_ptr<network::socket_t>>& network::NonBlockSocket_manager_t::GetReadyErrors() const
+{
+    return m_readyError;
 }
 
@@ -4,10 +4,13 @@
 
 #include <vector>
 #include <list>
+#include <deque>
 #include <map>
 #include <string>
+#include <memory>
 
 #include "log.h"
+#include "buffer.h"
 
 #ifdef __WIN32__
 
@@ -23,18 +26,50 @@
 #include <iphlpapi.h>
 #pragma comment(lib, "Ws2_32.lib") //       : ws2_32.dll.     
 #define CLOSE_SOCKET(socket) closesocket(socket)
+#define FILE_HANDLE HANDLE //   -   SendFile
+#define MSG_ZEROCOPY 0 //    , SendZeroCopy   Send
+#define SEND_NOSIGNAL 0 //       
 
 #else
 
 #include <arpa/inet.h>
 #include <sys/socket.h>
 #include <sys/poll.h>
+#include <sys/epoll.h>
+#include <sys/uio.h>
+#include <sys/sendfile.h>
+#include <netinet/in.h>
+#include <netinet/udp.h>
+#include <netinet/tcp.h>
+#include <linux/errqueue.h>
+#include <unistd.h>
 #include <fcntl.h>
+#include <signal.h>
 #include <errno.h>
 #include <string.h>
 #define SOCKET int
 #define INVALID_SOCKET -1
+#define FILE_HANDLE int
 #define CLOSE_SOCKET(socket) close(socket)
+#define SEND_NOSIGNAL MSG_NOSIGNAL //      EPIPE  SIGPIPE
+#ifndef UDP_SEGMENT
+#define UDP_SEGMENT 103 //   libc     UDP
+#endif
+#ifndef UDP_GRO
+#define UDP_GRO 104
+#endif
+#ifndef SO_ZEROCOPY
+#define SO_ZEROCOPY 60 //       4.14,  libc   
+#endif
+#ifndef MSG_ZEROCOPY
+#define MSG_ZEROCOPY 0x4000000
+#endif
+#ifndef SO_EE_ORIGIN_ZEROCOPY
+#define SO_EE_ORIGIN_ZEROCOPY 5
+#endif
+#ifndef SO_EE_CODE_ZEROCOPY_COPIED
+#define SO_EE_CODE_ZEROCOPY_COPIED 1
+#endif
 
 #endif
 
@@ -60,13 +95,17 @@ namespace network
         struct option_t //   
         {
             static const int NON_BLOCK = 1; //  
+            static const int REUSE_PORT = 2; //     ,      
+            static const int DUAL_STACK = 3; //  IPv6   IPv4 (IPV6_V6ONLY = 0),  IPv4   ::ffff:a.b.c.d
         };
         struct error_t //  
         {
 #ifdef __WIN32__
             static constexpr int NON_BLOCK_SOCKET_NOT_READY = WSAEWOULDBLOCK; //   ,      
+            static constexpr int DATAGRAM_TRUNCATED = WSAEMSGSIZE; //      
 #else
             static const int NON_BLOCK_SOCKET_NOT_READY = EWOULDBLOCK; //   ,      
+            static const int DATAGRAM_TRUNCATED = EMSGSIZE; //      
 #endif
         };
         /// <summary>
@@ -79,7 +118,7 @@ namespace network
         ///     
         /// </summary>
         /// <returns>    </returns>
-        int GetError();
+        int GetError() const;
 
         /// <summary>
         ///     
@@ -99,6 +138,8 @@ namespace network
         friend class UDP_socket_t; //   RecvFrom
         friend class TCP_socketServer_t; //   AddClient
         friend class TCP_socketClient_t; //   Move
+        friend class uringEngine_t; //   ,   io_uring
+        friend class dnsResolver_t; //      DNS
     protected:
         /// <summary>
         ///     .         UpdateSockInfo()
@@ -112,11 +153,17 @@ namespace network
         void UpdateSockInfo();
 
         /// <summary>
-        ///     ,    Addr
+        ///      (  )
         /// </summary>
-        /// <param name="ip"> IP    "..." </param>
-        /// <param name="port">   </param>
-        void UpdateSockInfo(std::string ip, unsigned short port);
+        void ResetSockInfo();
+
+        /// <summary>
+        ///      :  IPv4   IPv6   ::ffff:a.b.c.d
+        /// </summary>
+        /// <param name="addr"> -  ,    </param>
+        /// <param name="af"> -    </param>
+        /// <returns>      </returns>
+        static socklen_t MapAddr(sockaddr_storage& addr, int af);
 
     public:
         /// <summary>
@@ -128,7 +175,7 @@ namespace network
         /// <summary>
         ///   2- 
         /// </summary>
-        /// <param name="ip"> - IP    "..." </param>
+        /// <param name="ip"> - IP    "..."  IPv6, "::" -   IPv6  IPv4 ( ) </param>
         /// <param name="port"> -   </param>
         /// <param name="logger"> -     </param>
         sockInfo_t(std::string ip, unsigned short port, log_t& logger);
@@ -138,7 +185,7 @@ namespace network
         /// <summary>
         ///     
         /// </summary>
-        /// <param name="ip"> - IP    "..." </param>
+        /// <param name="ip"> - IP    "..."  IPv6, "::" -   IPv6  IPv4 ( ) </param>
         /// <param name="port"> -  </param>
         /// <returns> true - ; false -  </returns>
         bool setSockInfo(std::string ip, unsigned short port);
@@ -159,14 +206,14 @@ namespace network
         /// <summary>
         ///      
         /// </summary>
-        /// <returns>     </returns>
+        /// <returns>     (  ) </returns>
         size_t SizeAddr() const;
 
         /// <summary>
-        ///   IP
+        ///   IP.          
         /// </summary>
-        /// <returns> IP    "..." </returns>
-        std::string GetIP() const;
+        /// <returns> IP    "..."  IPv6,   -    </returns>
+        const std::string& GetIP() const;
 
         /// <summary>
         ///    
@@ -174,6 +221,19 @@ namespace network
         /// <returns>   </returns>
         unsigned short GetPort() const;
 
+        /// <summary>
+        ///    ,      
+        /// </summary>
+        /// <returns> AF_INET6 -  IPv6; AF_INET -  IPv4    </returns>
+        int GetFamily() const;
+
+        /// <summary>
+        ///       IP
+        /// </summary>
+        /// <param name="ip"> - IP    "..."  IPv6 ( ':') </param>
+        /// <returns> AF_INET6 -  IPv6; AF_INET -  </returns>
+        static int GetFamily(const std::string& ip);
+
         /// <summary>
         ///  
         /// </summary>
@@ -187,19 +247,39 @@ namespace network
         /// <param name="rValue"> -   </param>
         /// <returns> 1 -    </returns>
         bool operator != (const sockInfo_t& rValue) const;
+
+        /// <summary>
+        ///       (, , )
+        /// </summary>
+        /// <returns> ,   operator == </returns>
+        size_t Hash() const;
     protected:
-        std::pair<std::string, unsigned short> IP_port; // IP    
-        sockaddr Addr; //       
-        size_t sizeAddr; //   sockaddr
+        sockaddr_storage Addr; //   IPv4  IPv6   
+        mutable std::string s_IP; //   IP,   GetIP()
+        mutable bool b_IPvalid; //  s_IP  Addr
         log_t& logger; //    
     };
 
+    /// <summary>
+    ///          (,   )
+    /// </summary>
+    struct sockInfoHash_t
+    {
+        size_t operator()(const sockInfo_t& sockInfo) const
+        {
+            return sockInfo.Hash();
+        }
+    };
+
+    class NonBlockSocket_manager_t; //   ,  
+
     /// <summary>
     ///      
     /// </summary>
     class socket_t : public sockInfo_t
-    {// TODO   DNS    getaddrinfo(char const* node, char const* service, struct addrinfo const* hints, struct addrinfo** res)
+    {//      dnsResolver_t (dns.h),     
         friend class NonBlockSocket_manager_t; //   ,  setNonBlock
+        friend class dnsResolver_t; //      
     protected:
         /// <summary>
         ///     (     TCP)
@@ -210,7 +290,7 @@ namespace network
         bool SetSocket(SOCKET socket, bool nonBlock);
 
         /// <summary>
-        ///   
+        ///   . ,     ,     
         /// </summary>
         /// <returns> true -   </returns>
         bool Close();
@@ -220,6 +300,7 @@ namespace network
         ///   ,    ,   
         ///     -.
         ///        .
+        ///  IPv6       (IPV6_V6ONLY = 0):  "::",    IPv4.
         /// </summary>
         /// <returns> true - , false -  </returns>
         bool Bind();
@@ -229,7 +310,7 @@ namespace network
         ///   ,    ,   
         ///     -.
         /// </summary>
-        /// <param name="ip"> - IP    "..." </param>
+        /// <param name="ip"> - IP    "..."  IPv6, "::" -   IPv6  IPv4 ( ) </param>
         /// <param name="port"> -   </param>
         /// <returns> 1 -  </returns>
         bool Bind(std::string ip, unsigned short port);
@@ -244,7 +325,7 @@ namespace network
         ///   4- 
         /// </summary>
         /// <param name="af"> -  :       .     IPv4.
-        ///    AF_INET </param>
+        ///    AF_INET,  IPv6 - AF_INET6 </param>
         /// <param name="type"> -  :      TCP (SOCK_STREAM)  UDP (SOCK_DGRAM).
         ///       "" ,        .
         ///    SOCK_RAW </param>
@@ -257,13 +338,13 @@ namespace network
         ///    6 
         /// </summary>
         /// <param name="af"> -  :       .     IPv4.
-        ///    AF_INET </param>
+        ///    AF_INET,  IPv6 - AF_INET6 </param>
         /// <param name="type"> -  :      TCP (SOCK_STREAM)  UDP (SOCK_DGRAM).
         ///       "" ,        .
         ///    SOCK_RAW </param>
         /// <param name="protocol"> -  :  ,      TCP  UDP     0.
         /// </param>
-        /// <param name="ip"> - IP    "..." </param>
+        /// <param name="ip"> - IP    "..."  IPv6, "::" -   IPv6  IPv4 ( ) </param>
         /// <param name="port"> -   </param>
         /// <param name="logger"> -     </param>
         socket_t(int af, int type, int protocol, std::string ip, unsigned short port, log_t& logger);
@@ -272,7 +353,7 @@ namespace network
         ///    5 
         /// </summary>
         /// <param name="af"> -  :       .     IPv4.
-        ///    AF_INET </param>
+        ///    AF_INET,  IPv6 - AF_INET6 </param>
         /// <param name="type"> -  :      TCP (SOCK_STREAM)  UDP (SOCK_DGRAM).
         ///       "" ,        .
         ///    SOCK_RAW </param>
@@ -308,7 +389,10 @@ namespace network
         bool setNonBlock();
     protected:
         SOCKET Socket; //  
+        int af; //   , AF_UNSPEC -   
         bool nonBlock; //   
+    private:
+        std::vector<NonBlockSocket_manager_t*> v_manager; // ,     
     };
 
     /// <summary>
@@ -317,6 +401,9 @@ namespace network
     class TCP_socketClient_t : private socket_t
     {
         friend class TCP_socketServer_t; //      (  acept())
+        friend class uringEngine_t; //  io_uring       
+        friend class TCP_reactor_t; //       socket_t
+        friend class coReactor_t; //          
     private:
         /// <summary>
         ///  ,      ,       acept()
@@ -342,7 +429,7 @@ namespace network
         /// <summary>
         ///   3 
         /// </summary>
-        /// <param name="ip_server"> - IP     "..." </param>
+        /// <param name="ip_server"> - IP     "..."  IPv6,      </param>
         /// <param name="port_server"> -    </param>
         /// <param name="logger"> -   </param>
         TCP_socketClient_t(std::string ip_server, unsigned short port_server, log_t& logger);
@@ -350,7 +437,7 @@ namespace network
         /// <summary>
         ///   2 
         /// </summary>
-        /// <param name="serverSockInfo"> -    </param>
+        /// <param name="serverSockInfo"> -   ,       </param>
         /// <param name="logger"> -   </param>
         TCP_socketClient_t(sockInfo_t serverSockInfo, log_t& logger);
 
@@ -367,6 +454,27 @@ namespace network
         ///           -3 -    ( )</returns>
         int Recive(std::string& str_bufer, const std::string str_EndOfMessege = "", const size_t sizeMsg = 0);
 
+        /// <summary>
+        ///        ,    (  )
+        /// </summary>
+        /// <param name="buffer"> -     </param>
+        /// <returns> N>0 -  N ;
+        ///           -1 -  ;
+        ///           -2 -     ;
+        ///           -3 -    ( )</returns>
+        int Recive(slice_t buffer);
+
+        /// <summary>
+        ///         
+        /// </summary>
+        /// <param name="buffer"> -  ,      </param>
+        /// <param name="minSize"> -       </param>
+        /// <returns> N>0 -  N ;
+        ///           -1 -  ;
+        ///           -2 -     ;
+        ///           -3 -    ( )</returns>
+        int Recive(buffer_t& buffer, size_t minSize = 2048);
+
         /// <summary>
         ///            
         /// </summary>
@@ -378,6 +486,103 @@ namespace network
         ///           -3 -      ( )</returns>
         int Send(const std::string& str_bufer);
 
+        /// <summary>
+        ///          (writev/WSASend)    
+        ///  .    ,  -   :   
+        ///    N ,      
+        /// </summary>
+        /// <param name="parts"> -     </param>
+        /// <param name="count"> -   </param>
+        /// <param name="more"> -      (MSG_MORE):      </param>
+        /// <returns> 0 -   ;
+        ///           N>0 -  N ;
+        ///           -1 -  ;
+        ///           -2 -     ;
+        ///           -3 -      ( )</returns>
+        int Send(const slice_t* parts, size_t count, bool more = false);
+
+        /// <summary>
+        ///         
+        /// </summary>
+        /// <param name="parts"> -     </param>
+        /// <param name="more"> -      (MSG_MORE) </param>
+        /// <returns>  Send(parts, count, more) </returns>
+        int Send(const std::vector<slice_t>& parts, bool more = false);
+
+        /// <summary>
+        ///  ""  (TCP_CORK):   ,      ,
+        ///    .       Send  
+        /// </summary>
+        /// <param name="enable"> - 1 - ; 0 -     </param>
+        /// <returns> 1 -   </returns>
+        bool SetCork(bool enable);
+
+        /// <summary>
+        ///          (Linux - sendfile).   
+        /// offset  count,           .
+        ///  Windows       send
+        /// </summary>
+        /// <param name="file"> -   </param>
+        /// <param name="offset"> -   ,    </param>
+        /// <param name="count"> -   ,   ;     -    </param>
+        /// <returns> 0 -      ;
+        ///           N>0 -  N ,      ( );
+        ///           -1 -  ;
+        ///           -2 -     ;
+        ///           -3 -      ( )</returns>
+        int SendFile(FILE_HANDLE file, long long& offset, size_t& count);
+
+        /// <summary>
+        ///      (pipe)        (Linux - splice).
+        ///     " " ,      
+        /// </summary>
+        /// <param name="pipe"> -     </param>
+        /// <param name="count"> -   ,    </param>
+        /// <returns> 0 -       ;
+        ///           N>0 -  N ,    ( );
+        ///           -1 -   ( Windows -  );
+        ///           -2 -     ;
+        ///           -3 -      ( )</returns>
+        int SendPipe(int pipe, size_t& count);
+
+        /// <summary>
+        ///       (Linux - SO_ZEROCOPY).    SendZeroCopy 
+        ///   ,            (ReapZeroCopy)
+        /// </summary>
+        /// <param name="enable"> - 1 - ; 0 -  (      ) </param>
+        /// <returns> 1 -   </returns>
+        bool SetZeroCopy(bool enable);
+
+        /// <summary>
+        ///        (MSG_ZEROCOPY).     ,    
+        ///  ,    ,  GetZeroCopyPending    .
+        ///        Send.      
+        /// </summary>
+        /// <param name="buffer"> -    </param>
+        /// <param name="offset"> -     (   ) </param>
+        /// <returns> 0 -   ;
+        ///           N>0 -  N ;
+        ///           -1 -  ;
+        ///           -2 -     ;
+        ///           -3 -      ( )</returns>
+        int SendZeroCopy(const std::shared_ptr<const std::string>& buffer, size_t offset = 0);
+
+        /// <summary>
+        ///               .
+        /// ,        (NonBlockSocket_manager_t::GetReadyErrors),
+        ///     .  TCP     
+        /// </summary>
+        /// <returns> N>=0 -  N ; -1 -   </returns>
+        int ReapZeroCopy();
+
+        /// <summary>
+        ///      ,    
+        /// </summary>
+        /// <returns>      </returns>
+        size_t GetZeroCopyPending() const;
+
+        static const size_t PARTS_MAX = 64; //        
+
         /// <summary>
         ///      
         /// </summary>
@@ -392,6 +597,9 @@ namespace network
     private:
         bool b_connected; //     
         sockInfo_t serverInfo; //   
+        bool b_zeroCopy; //     
+        unsigned int zeroCopyNext; //      (    )
+        std::deque<std::pair<unsigned int, std::shared_ptr<const std::string>>> d_zeroCopy; // ,  :   - 
     };
 
     /// <summary>
@@ -399,11 +607,14 @@ namespace network
     /// </summary>
     class TCP_socketServer_t : private socket_t
     {
+        friend class uringEngine_t; //  io_uring    accept   
+        friend class TCP_reactor_t; //       socket_t
+        friend class coReactor_t; //       
     public:
         /// <summary>
         ///   3- 
         /// </summary>
-        /// <param name="ip"> - IP    "..." </param>
+        /// <param name="ip"> - IP    "..."  IPv6, "::" -   IPv6  IPv4 ( ) </param>
         /// <param name="port"> -   </param>
         /// <param name="logger"> -   </param>
         TCP_socketServer_t(std::string ip, unsigned short port, log_t& logger);
@@ -415,6 +626,22 @@ namespace network
         /// <param name="logger"> -   </param>
         TCP_socketServer_t(sockInfo_t sockInfo, log_t& logger);
 
+        /// <summary>
+        ///   4- ,        (    )
+        /// </summary>
+        /// <param name="ip"> - IP    "..."  IPv6, "::" -   IPv6  IPv4 ( ) </param>
+        /// <param name="port"> -   </param>
+        /// <param name="reusePort"> - 1 -        (SO_REUSEPORT),  
+        ///      </param>
+        /// <param name="logger"> -   </param>
+        TCP_socketServer_t(std::string ip, unsigned short port, bool reusePort, log_t& logger);
+
+        /// <summary>
+        ///         
+        /// </summary>
+        /// <returns> 1 -       SO_REUSEPORT </returns>
+        static bool ReusePortSupported();
+
         /// <summary>
         ///    
         /// </summary>
@@ -423,6 +650,110 @@ namespace network
         ///          -1 -  ,
         ///          -2 -       ( )</returns>
         int AddClient(TCP_socketClient_t& client);
+
+        /// <summary>
+        ///    
+        /// </summary>
+        /// <returns> 1 -  ; 0 - ,      (  ) </returns>
+        bool GetListening() const;
+    private:
+        bool b_listening; //   
+    };
+
+    /// <summary>
+    ///    /     (recvmmsg/sendmmsg).
+    /// ,         ;  
+    ///          
+    /// </summary>
+    class datagramBatch_t
+    {
+        friend class UDP_socket_t; //    
+    public:
+        /// <summary>
+        /// 
+        /// </summary>
+        /// <param name="capacity"> -      </param>
+        /// <param name="size"> -     </param>
+        datagramBatch_t(size_t capacity, size_t size = 2048);
+
+        //  -      
+        datagramBatch_t(const datagramBatch_t& batch) = delete;
+        datagramBatch_t& operator = (const datagramBatch_t& batch) = delete;
+
+        /// <summary>
+        ///       
+        /// </summary>
+        void Clear();
+
+        /// <summary>
+        ///     
+        /// </summary>
+        /// <param name="data"> -  </param>
+        /// <param name="size"> -  ,      </param>
+        /// <param name="target"> -  </param>
+        /// <returns> 1 - ; 0 -       </returns>
+        bool Add(const char* data, size_t size, const sockInfo_t& target);
+
+        /// <summary>
+        ///      
+        /// </summary>
+        /// <returns>   </returns>
+        size_t Count() const;
+
+        /// <summary>
+        ///    
+        /// </summary>
+        /// <returns>    </returns>
+        size_t Capacity() const;
+
+        /// <summary>
+        ///    
+        /// </summary>
+        /// <param name="index"> -   </param>
+        /// <returns>  ,       </returns>
+        slice_t Data(size_t index) const;
+
+        /// <summary>
+        ///    /    
+        /// </summary>
+        /// <param name="index"> -   </param>
+        /// <returns>   </returns>
+        const sockaddr* Peer(size_t index) const;
+
+        /// <summary>
+        ///   IP /  (   )
+        /// </summary>
+        /// <param name="index"> -   </param>
+        /// <returns> IP    "..." </returns>
+        std::string PeerIP(size_t index) const;
+
+        /// <summary>
+        ///    / 
+        /// </summary>
+        /// <param name="index"> -   </param>
+        /// <returns>   </returns>
+        unsigned short PeerPort(size_t index) const;
+
+        /// <summary>
+        ///     
+        /// </summary>
+        /// <param name="index"> -   </param>
+        /// <returns> 1 -   ,  Data   ; 0 -   </returns>
+        bool Truncated(size_t index) const;
+
+    protected:
+        const size_t CAPACITY; //   
+        const size_t SIZE; //    
+        size_t count; //    
+        std::unique_ptr<char[]> p_data; //     
+        std::vector<size_t> v_size; //  
+        std::vector<bool> v_truncated; //    
+        std::vector<sockaddr_storage> v_peer; // 
+        std::vector<socklen_t> v_peerLen; //  
+#ifndef __WIN32__
+        std::vector<iovec> v_iov; //    recvmmsg/sendmmsg
+        std::vector<mmsghdr> v_msg; //    recvmmsg/sendmmsg
+#endif
     };
 
     /// <summary>
@@ -432,7 +763,7 @@ namespace network
     {
     private:
         /// <summary>
-        ///   MTU
+        ///   MTU   
         /// </summary>
         void setMTU();
     public:
@@ -449,10 +780,17 @@ namespace network
         /// <param name="logger"> -    </param>
         UDP_socket_t(log_t& logger);
 
+        /// <summary>
+        ///   2 ,     
+        /// </summary>
+        /// <param name="af"> -  : AF_INET  AF_INET6 ( ,     IPv4) </param>
+        /// <param name="logger"> -    </param>
+        UDP_socket_t(int af, log_t& logger);
+
         /// <summary>
         ///   3- 
         /// </summary>
-        /// <param name="ip"> - IP    "..." </param>
+        /// <param name="ip"> - IP    "..."  IPv6, "::" -   IPv6  IPv4 ( ) </param>
         /// <param name="port"> -   </param>
         /// <param name="logger"> -   </param>
         UDP_socket_t(std::string ip, unsigned short port, log_t& logger);
@@ -474,7 +812,7 @@ namespace network
         ///          -1 -  ;
         ///          -2 -    MTU    ;
         ///          -3 -      ( ) </returns>
-        int SendTo(const std::string& buffer, sockInfo_t target);
+        int SendTo(const std::string& buffer, const sockInfo_t& target);
 
         /// <summary>
         ///        ,       
@@ -513,6 +851,52 @@ namespace network
         ///             -3 -    ();</returns>
         int RecvFrom(std::string& buffer, const std::string str_EndOfMessege = "", const size_t sizeMsg = 0);
 
+        /// <summary>
+        ///        ,    (  )
+        /// </summary>
+        /// <param name="buffer"> -    ,      </param>
+        /// <returns>   N>0 -  N-;
+        ///             -1 -  ;
+        ///             -2 -      ;
+        ///             -3 -    ();</returns>
+        int RecvFrom(slice_t buffer);
+
+        /// <summary>
+        ///         
+        /// </summary>
+        /// <param name="buffer"> -  ,      </param>
+        /// <param name="minSize"> -       </param>
+        /// <returns>   N>0 -  N-;
+        ///             -1 -  ;
+        ///             -2 -      ;
+        ///             -3 -    ();</returns>
+        int RecvFrom(buffer_t& buffer, size_t minSize = 2048);
+
+        /// <summary>
+        ///         (Linux - recvmmsg).    
+        ///        ,     .
+        ///      -     .
+        ///           (. Truncated)
+        /// </summary>
+        /// <param name="batch"> - ,    </param>
+        /// <returns>   N>0 -  N ;
+        ///             -1 -  ;
+        ///             -2 -   ;
+        ///             -3 -    ();</returns>
+        int RecvBatch(datagramBatch_t& batch);
+
+        /// <summary>
+        ///         (Linux - sendmmsg).
+        ///       ,   ,
+        ///      (-1  )
+        /// </summary>
+        /// <param name="batch"> - ,   Add </param>
+        /// <returns>   N>=0 -  N    (   Count);
+        ///             -1 -   (      );
+        ///             -2 -   ;
+        ///             -3 -    ();</returns>
+        int SendBatch(datagramBatch_t& batch);
+
         /// <summary>
         ///           (/ )
         /// </summary>
@@ -524,9 +908,42 @@ namespace network
         /// </summary>
         /// <returns>    </returns>
         unsigned int MTU() const;
+
+        /// <summary>
+        ///    /  (Linux - UDP_SEGMENT/UDP_GRO).
+        ///    SendTo         SegmentSize()   
+        ///  ,         -   
+        ///  RecvSegments,    
+        /// </summary>
+        /// <param name="enable"> - 1 - ; 0 -  </param>
+        /// <param name="segmentSize"> -  , 0 -   MTU Ethernet (. SegmentSize) </param>
+        /// <returns> 1 -   </returns>
+        bool SetSegmentation(bool enable, unsigned int segmentSize = 0);
+
+        /// <summary>
+        ///    
+        /// </summary>
+        /// <returns>         </returns>
+        unsigned int SegmentSize() const;
+
+        /// <summary>
+        ///      ( ).      
+        /// </summary>
+        /// <param name="buffer"> -    ,      64  </param>
+        /// <param name="segmentSize"> -  :   -   segmentSize ,     </param>
+        /// <returns>   N>0 -  N-;
+        ///             -1 -  ;
+        ///             -2 -      ;
+        ///             -3 -    ();</returns>
+        int RecvSegments(slice_t buffer, unsigned int& segmentSize);
+
+        static const unsigned int SEGMENTS_MAX = 64; //       
     private:
         sockInfo_t lastCommunicationSocket; //  ,    
         unsigned int u32_MTU; //    
+        unsigned int u32_segment; //     
+        bool b_segmentation; //   
+        int batchError; //    ,    SendBatch
     };
 
     /// <summary>
@@ -534,6 +951,7 @@ namespace network
     /// </summary>
     class NonBlockSocket_manager_t : private RAII_OSsock
     {
+        friend class socket_t; //        (. Forget)
     protected:
         /// <summary>
         ///       
@@ -551,10 +969,32 @@ namespace network
         /// <returns> 1 -   </returns>
         bool deleteSocket(std::map<int, std::shared_ptr<socket_t>>& m_sock, std::shared_ptr<socket_t> socket);
 
+        /// <summary>
+        ///      ,        
+        /// </summary>
+        /// <param name="socket"> -  </param>
+        void Unlink(socket_t& socket);
+
+        /// <summary>
+        ///        ( socket_t::Close  ).
+        ///  ,     ,        epoll
+        /// </summary>
+        /// <param name="fd"> -   </param>
+        void Forget(int fd);
+
+#ifdef __WIN32__
         /// <summary>
         ///    pollfd
         /// </summary>
         void UpdatePollfd();
+#else
+        /// <summary>
+        ///      epoll,      
+        /// </summary>
+        /// <param name="fd"> -   </param>
+        /// <returns> 1 -  epoll  </returns>
+        bool UpdateEpoll(int fd);
+#endif
 
         /// <summary>
         ///    
@@ -574,7 +1014,15 @@ namespace network
         /// </summary>
         /// <param name="size"> -     </param>
         /// <param name="logger"> -    </param>
-        NonBlockSocket_manager_t(int size, log_t& logger);
+        /// <param name="edgeTriggered"> -     ( epoll):          ,
+        ///     //   -3 (-2  AddClient ) </param>
+        NonBlockSocket_manager_t(int size, log_t& logger, bool edgeTriggered = false);
+
+        //  -  epoll  
+        NonBlockSocket_manager_t(const NonBlockSocket_manager_t& manager) = delete;
+        NonBlockSocket_manager_t& operator = (const NonBlockSocket_manager_t& manager) = delete;
+
+        virtual ~NonBlockSocket_manager_t();
 
         /// <summary>
         ///   
@@ -666,8 +1114,34 @@ namespace network
         /// <param name="timeOut"> -    </param>
         /// <returns> 1 -      </returns>
         bool Work(const int timeOut);
+
+        /// <summary>
+        ///         Work(),       GetReadyReader
+        /// </summary>
+        /// <returns>    -  </returns>
+        const std::map<int, std::shared_ptr<socket_t>>& GetReadyReaders() const;
+
+        /// <summary>
+        ///         Work()
+        /// </summary>
+        /// <returns>    -  </returns>
+        const std::map<int, std::shared_ptr<socket_t>>& GetReadySenders() const;
+
+        /// <summary>
+        ///     ,    Work()     
+        ///  (       , . TCP_socketClient_t::ReapZeroCopy)
+        /// </summary>
+        /// <returns>    -  </returns>
+        const std::map<int, std::shared_ptr<socket_t>>& GetReadyErrors() const;
     protected:
+#ifdef __WIN32__
         std::vector <struct pollfd> v_fds; //    pollfd
+#else
+        int epollFd; //   epoll,     
+        std::vector <struct epoll_event> v_events; //   ,  epoll_wait
+        std::map<int, unsigned> m_epollMask; //  ,      epoll
+        bool edgeTriggered; //     (EPOLLET)
+#endif
         std::map<int, std::shared_ptr<socket_t>> m_senderSocket; //    
         std::map<int, std::shared_ptr<socket_t>> m_readerSocket; //    
         std::map<int, std::shared_ptr<socket_t>> m_serverSocket; //     
@@ -676,7 +1150,9 @@ namespace network
         std::map<int, std::shared_ptr<socket_t>> m_readyReader; //   
         std::map<int, std::shared_ptr<socket_t>> m_readyServer; //   
         std::map<int, std::shared_ptr<socket_t>> m_readyClient; //   
-        bool b_change; //    pollfd
+        std::map<int, std::shared_ptr<socket_t>> m_readyError; //    / 
+        std::vector<std::shared_ptr<socket_t>> v_closed; // ,  Forget,    Work: Close      
+        bool b_change; //    pollfd ( poll)
         log_t& logger; //  
     };
 };
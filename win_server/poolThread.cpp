@@ -1,231 +1,501 @@
 #include "poolThread.h"
 
-/// <summary>
-///   
-/// </summary>
-task_t::task_t(std::condition_variable& cv_wakeUp, std::mutex& mtx_wakeUp) : cv_wakeUp(cv_wakeUp), mtx_wakeUp(mtx_wakeUp), b_stop(false), b_active(false), p_userTask(nullptr)
-{}
+#include <algorithm>
+
+thread_local poolThread_manager_t::worker_t* poolThread_manager_t::p_currentWorker = nullptr;
 
 /// <summary>
-///   .    
+///    
 /// </summary>
-void task_t::Work()
+/// <param name="worker"> -   </param>
+void poolThread_manager_t::Work(worker_t& worker)
 {
-	bool wakeUp = false; //        
+	queuedTask_t task;
+	p_currentWorker = &worker;
+	//      ( ) -     
+	unsigned generation = placementGen.load(std::memory_order_acquire);
+	if (placement.load(std::memory_order_relaxed) != placement_t::NONE)
+		Place(worker);
+	else
+		worker.placed = generation;
 
-	while (!b_stop)
+	while (!stop)
 	{
-		std::unique_lock<std::mutex> lock(mutex);
-		if (!b_stop)
-			cv_condition.wait(lock, [this]() { return b_active; });//   
-
-		if (!b_stop && p_userTask != nullptr/* && b_active */) //    
+		if (worker.placed != placementGen.load(std::memory_order_acquire))
+			Place(worker);
+		if (PopTask(worker, task))
 		{
-			p_userTask->Work(b_stop); //   
-			p_userTask = nullptr; //   
-			b_active = false; //   , 
-			wakeUp = true; //  
+			if (MAX_SIZE > MIN_SIZE)
+				MeasureWait(task);
+			SetStatus(task.ID, EXCEPTION, ACTIVE);
+			task.p_task->Work(stop); //   
+			task.p_task = nullptr; //   
+			SetStatus(task.ID, ACTIVE, COMPLECTED);
+			if (task.p_future != nullptr)
+			{ //    :          
+				std::shared_ptr<futureState_t> p_future = std::move(task.p_future);
+				p_future->Complete();
+			}
 		}
-		lock.unlock(); //   
-		//     
-		if (wakeUp)
-		{
-			wakeUp = false;
-			std::lock_guard<std::mutex> lock(mtx_wakeUp);
-			cv_wakeUp.notify_one();
+		else
+		{ //   - ;      ,    
+			std::unique_lock<std::mutex> lock(mutex);
+			bool idle = false;
+			sleeping.fetch_add(1);
+			if (MAX_SIZE > MIN_SIZE) //     :     
+				idle = !cv_condition.wait_for(lock, IDLE_TIMEOUT, [this, &worker]() { return stop || HasTasks() || worker.placed != placementGen.load(); });
+			else
+				cv_condition.wait(lock, [this, &worker]() { return stop || HasTasks() || worker.placed != placementGen.load(); });
+			sleeping.fetch_sub(1);
+			//        -       
+			if (idle && active.load() > MIN_SIZE)
+			{ //    (  ),     
+				active.fetch_sub(1);
+				worker.running.store(false);
+				return;
+			}
 		}
 	}
 }
 
 /// <summary>
-///   
+///           
 /// </summary>
-/// <param name="userTask"> -      </param>
-/// <returns> 1 -   </returns>
-bool task_t::UpdateTask(std::shared_ptr<ABStask> userTask)
+/// <param name="task"> -   </param>
+void poolThread_manager_t::MeasureWait(const queuedTask_t& task)
+{
+	long long now = Now();
+	lastPop.store(now, std::memory_order_relaxed);
+	//     1/8:     ,  - .
+	//       ,    
+	long long average = avgWait.load(std::memory_order_relaxed);
+	average += (now - task.queued - average) / 8;
+	avgWait.store(average, std::memory_order_relaxed);
+
+	if (average > WAIT_TARGET)
+		CheckGrow(now);
+}
+
+/// <summary>
+///    ,    ,        
+/// </summary>
+/// <param name="now"> -     </param>
+void poolThread_manager_t::CheckGrow(long long now)
+{
+	if (sleeping.load() == 0 && active.load() < MAX_SIZE && now - lastGrow.load(std::memory_order_relaxed) > WAIT_TARGET)
+		Grow();
+}
+
+/// <summary>
+///       
+/// </summary>
+/// <returns> 1 -   </returns>
+bool poolThread_manager_t::Grow()
 {
 	bool result = false;
+	//    ,   ;   ,   
+	std::unique_lock<std::mutex> lock(mtx_resize, std::try_to_lock);
 
-	if (mutex.try_lock()) //   
-	{ //      
-		if (!b_active && p_userTask == nullptr)
-		{ //    
-			p_userTask = userTask; //  
-			b_active = true;
-			cv_condition.notify_one();
-			result = true;
-		}
-		mutex.unlock();
+	if (lock.owns_lock() && !stop && active.load() < MAX_SIZE)
+	{
+		for (size_t index = 0; index < v_worker.size() && !result; ++index)
+			if (!v_worker[index]->running.load())
+			{
+				if (v_thread[index].joinable())
+					v_thread[index].join(); //       Work
+				v_worker[index]->running.store(true);
+				active.fetch_add(1);
+				try
+				{
+					v_thread[index] = std::thread([this, index]() { Work(*v_worker[index]); });
+					result = true;
+				}
+				catch (const std::system_error&)
+				{ //     -  ,  
+					active.fetch_sub(1);
+					v_worker[index]->running.store(false);
+					break;
+				}
+			}
+		lastGrow.store(Now(), std::memory_order_relaxed);
 	}
 
 	return result;
 }
 
 /// <summary>
-///   
+///      
+/// </summary>
+/// <returns>      </returns>
+long long poolThread_manager_t::Now()
+{
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/// <summary>
+///   :   ,    
 /// </summary>
-/// <returns> 1 -   </returns>
-bool task_t::GetActive() const
+/// <param name="task"> -   </param>
+/// <returns> 1 -   </returns>
+bool poolThread_manager_t::Pop(queuedTask_t& task)
 {
-	bool result = true;
+	if (queue.TryPop(task))
+		return true;
 
-	if (mutex.try_lock())
-	{ //   
-		result = b_active;
-		mutex.unlock();
+	if (overflowSize.load(std::memory_order_acquire) != 0)
+	{ //   -    
+		std::lock_guard<std::mutex> lock(mtx_overflow);
+		if (!d_overflow.empty())
+		{
+			task = std::move(d_overflow.front());
+			d_overflow.pop_front();
+			overflowSize.fetch_sub(1, std::memory_order_release);
+			return true;
+		}
 	}
-	//     ,   
-	return result;
+
+	return false;
 }
 
 /// <summary>
-///     
+///      :  ,  ,  
 /// </summary>
-void task_t::Stop()
+/// <param name="worker"> -   </param>
+/// <param name="task"> -   </param>
+/// <returns> 1 -   </returns>
+bool poolThread_manager_t::PopStealing(worker_t& worker, queuedTask_t& task)
 {
-	b_stop = true; //    
+	queuedTask_t* p_task = worker.deque.Pop(); //    -       
+	worker_t* p_owner = &worker; //     
+	if (p_task == nullptr && Pop(task))
+		return true;
 
-	if (mutex.try_lock())
-	{ //   ,     
-		if (!b_active)
-		{ // 
-			b_active = true; // 
-			cv_condition.notify_one();
+	if (p_task == nullptr && v_worker.size() > 1)
+	{ //    -      ,   
+		worker.seed ^= worker.seed << 13; // xorshift32
+		worker.seed ^= worker.seed >> 17;
+		worker.seed ^= worker.seed << 5;
+		size_t start = worker.seed % v_worker.size();
+		for (size_t index = 0; index < v_worker.size() && p_task == nullptr; ++index)
+		{
+			worker_t& victim = *v_worker[(start + index) % v_worker.size()];
+			if (&victim != &worker && (p_task = victim.deque.Steal()) != nullptr)
+				p_owner = &victim;
 		}
-		mutex.unlock();
 	}
+
+	if (p_task != nullptr)
+	{
+		task = std::move(*p_task);
+		FreeLocal(*p_owner, p_task);
+		return true;
+	}
+
+	return false;
 }
 
 /// <summary>
-/// 
+///    ,   ,     
 /// </summary>
-task_t::~task_t()
-{}
+/// <param name="owner"> - ,       </param>
+/// <param name="p_task"> -   </param>
+void poolThread_manager_t::FreeLocal(worker_t& owner, queuedTask_t* p_task)
+{
+	p_task->~queuedTask_t();
+	owner.taskSlab.Free(p_task);
+}
 
 /// <summary>
-///   
+///       NUMA
 /// </summary>
-thread_t::thread_t(std::condition_variable& cv_wakeUp, std::mutex& mtx_wakeUp) : thread([this](){ task.Work(); }), task(cv_wakeUp, mtx_wakeUp)
-{}
-
-///
-thread_t::~thread_t()
+/// <param name="worker"> -   </param>
+/// <param name="task"> -   </param>
+/// <param name="own"> - 1 -    ; 0 -    </param>
+/// <returns> 1 -   </returns>
+bool poolThread_manager_t::PopNode(worker_t& worker, queuedTask_t& task, bool own)
 {
-	task.Stop(); //  
-	thread.join(); //   
+	if (v_nodeQueue.empty())
+		return false;
+
+	int node = worker.node.load(std::memory_order_relaxed);
+	if (own)
+		return node >= 0 && v_nodeQueue[node]->TryPop(task);
+
+	for (size_t index = 0; index < v_nodeQueue.size(); ++index)
+		if (int(index) != node && v_nodeQueue[index]->TryPop(task))
+			return true;
+
+	return false;
 }
 
 /// <summary>
-/// 
+///         
 /// </summary>
-/// <param name="cv_wakeUp"> -     -     </param>
-/// <param name="mtx_wakeUp"> -    </param>
-poolThread_t::poolThread_t(std::condition_variable& cv_wakeUp, std::mutex& mtx_wakeUp, const size_t SIZE) : SIZE(SIZE), free(false)
+/// <param name="worker"> -   </param>
+/// <param name="task"> -   </param>
+/// <returns> 1 -   </returns>
+bool poolThread_manager_t::PopTask(worker_t& worker, queuedTask_t& task)
 {
-	v_thread.reserve(SIZE);
-	v_taskID.reserve(SIZE);
-	for (size_t index = 0; index < SIZE; ++index)
-	{   //   ,    
-		v_thread.push_back(std::make_shared<thread_t>(cv_wakeUp, mtx_wakeUp));
-		v_taskID.push_back(0);
+	static const int s_order[3][priority_t::COUNT] = {
+		{ priority_t::HIGH, priority_t::NORMAL, priority_t::LOW },
+		{ priority_t::NORMAL, priority_t::HIGH, priority_t::LOW },
+		{ priority_t::LOW, priority_t::HIGH, priority_t::NORMAL } };
+
+	if (PopScheduled(task, -1)) //   -     
+		return true;
+
+	//      ,     
+	++worker.turn;
+	const int* p_order = s_order[worker.turn % LOW_TURN == 0 ? 2 : (worker.turn % NORMAL_TURN == 0 ? 1 : 0)];
+	for (int index = 0; index < priority_t::COUNT; ++index)
+	{
+		if (PopScheduled(task, p_order[index]))
+			return true;
+		//  NORMAL  :   ,    (  ),    
+		if (p_order[index] == priority_t::NORMAL &&
+			(PopNode(worker, task, true) || (workStealing ? PopStealing(worker, task) : Pop(task)) || PopNode(worker, task, false)))
+			return true;
 	}
+
+	return false;
 }
 
 /// <summary>
-///   
+///      .       
 /// </summary>
-/// <param name="userTask"> -      </param>
-/// <returns> INVALID_TASK -   ; ID>INVALID_TASK - ID  </returns>
-bool poolThread_t::UpdateTask(std::shared_ptr<ABStask> userTask, taskID ID)
+/// <param name="task"> -   </param>
+/// <param name="priority"> -  priority_t; -1 -   ,    </param>
+/// <returns> 1 -   </returns>
+bool poolThread_manager_t::PopScheduled(queuedTask_t& task, int priority)
 {
-	for (size_t index = 0; index < SIZE; ++index) //   
-		if (!v_thread[index]->task.GetActive())
-			if (v_thread[index]->task.UpdateTask(userTask)) //   
+	bool empty = true;
+	for (int index = 0; index < priority_t::COUNT && empty; ++index)
+		if ((priority < 0 || priority == index) && scheduledSize[index].load(std::memory_order_acquire) != 0)
+			empty = false;
+	if (empty) //   -      
+		return false;
+
+	bool result = false;
+	std::vector<queuedTask_t> v_expired;
+	{
+		std::lock_guard<std::mutex> lock(mtx_scheduled);
+		long long now = Now();
+		int found = -1;
+		for (int index = 0; index < priority_t::COUNT; ++index)
+		{
+			if (priority >= 0 && priority != index)
+				continue;
+			std::vector<queuedTask_t>& v_heap = v_scheduled[index];
+			//     -    
+			while (!v_heap.empty() && v_heap.front().deadline != 0 && v_heap.front().deadline <= now)
 			{
-				v_taskID[index] = ID; //  ID
-				free = false;
-				return true;
+				std::pop_heap(v_heap.begin(), v_heap.end(), laterTask_t());
+				v_expired.push_back(std::move(v_heap.back()));
+				v_heap.pop_back();
 			}
+			scheduledSize[index].store(v_heap.size(), std::memory_order_release);
+
+			if (v_heap.empty())
+				continue;
+			if (priority >= 0)
+				found = index;
+			else if (v_heap.front().deadline != 0 && v_heap.front().deadline - now <= deadlineSlack.load(std::memory_order_relaxed) &&
+				(found < 0 || v_heap.front().deadline < v_scheduled[found].front().deadline))
+				found = index; //     -  
+		}
+
+		if (found >= 0)
+		{
+			std::vector<queuedTask_t>& v_heap = v_scheduled[found];
+			std::pop_heap(v_heap.begin(), v_heap.end(), laterTask_t());
+			task = std::move(v_heap.back());
+			v_heap.pop_back();
+			scheduledSize[found].store(v_heap.size(), std::memory_order_release);
+			result = true;
+		}
+	}
+
+	for (size_t index = 0; index < v_expired.size(); ++index) //  :    
+		Expire(v_expired[index]);
+
+	return result;
+}
 
-	return free = false;
+/// <summary>
+///      :  EXPIRED,      
+/// </summary>
+/// <param name="task"> -   </param>
+void poolThread_manager_t::Expire(queuedTask_t& task)
+{
+	task.p_task = nullptr;
+	SetStatus(task.ID, EXCEPTION, EXPIRED);
+	expiredCount.fetch_add(1, std::memory_order_relaxed);
+	if (task.p_future != nullptr)
+	{
+		std::shared_ptr<futureState_t> p_future = std::move(task.p_future);
+		p_future->expired.store(true, std::memory_order_relaxed); // Complete     
+		p_future->Complete();
+	}
 }
 
 /// <summary>
-///    
+///      :      
 /// </summary>
-/// <param name="ID"> - ID   </param>
-/// <returns> 1 -   </returns>
-bool poolThread_t::GetActiveTask(taskID ID)
+/// <param name="p_future"> -   , nullptr -    </param>
+void poolThread_manager_t::Cancel(std::shared_ptr<futureState_t> p_future)
 {
-	for (size_t index = 0; index < SIZE; ++index)
-		if (v_taskID[index] == ID)
-			return v_thread[index]->task.GetActive();
+	if (p_future != nullptr)
+	{
+		p_future->cancelled.store(true, std::memory_order_relaxed); // Complete     
+		p_future->Complete();
+	}
+}
 
-	return false;
+/// <summary>
+///        
+/// </summary>
+/// <param name="worker"> -   </param>
+void poolThread_manager_t::Place(worker_t& worker)
+{
+	worker.placed = placementGen.load(std::memory_order_acquire);
+	int node = PlaceThread(placement.load(std::memory_order_relaxed), worker.index);
+	worker.node.store(node < int(v_nodeQueue.size()) ? node : -1, std::memory_order_relaxed);
 }
 
 /// <summary>
-///     
+///       
 /// </summary>
-/// <returns> 1 -       </returns>
-bool poolThread_t::GetFree() const
+/// <returns> 1 -         </returns>
+bool poolThread_manager_t::HasTasks() const
 {
-	bool result = free;
-	if (!result)
-		for (size_t index = 0; index < SIZE; ++index) //   
-			if (!v_thread[index]->task.GetActive())
-				free = result = true;
+	if (!queue.Empty() || overflowSize.load() != 0)
+		return true;
 
-	return result;
+	for (size_t index = 0; index < v_nodeQueue.size(); ++index)
+		if (!v_nodeQueue[index]->Empty())
+			return true;
+
+	for (int index = 0; index < priority_t::COUNT; ++index)
+		if (scheduledSize[index].load() != 0)
+			return true;
+
+	if (workStealing)
+		for (size_t index = 0; index < v_worker.size(); ++index)
+			if (!v_worker[index]->deque.Empty())
+				return true;
+
+	return false;
 }
 
 /// <summary>
-///    
+///       
 /// </summary>
-void poolThread_manager_t::Update()
-{
-	while (!stop)
-	{
-		std::unique_lock<std::mutex> lock(mutex);
-		if (!stop) //      /    
-			cv_condition.wait(lock, [this]() { return stop || slave_pool.GetFree(); });
-		if (!stop)
-		{
-			std::map<taskID, status_p_task_t>::iterator iter = m_task.begin();
-			std::map<taskID, status_p_task_t>::iterator end = m_task.end();
-			while (iter != end) //       taskID     
-				if (iter->second.status == EXCEPTION && slave_pool.UpdateTask(iter->second.p_task, iter->first))
-				{ //           -   
-					iter->second.status = ACTIVE;
-					++iter;
-				}
-				else if (iter->second.status == ACTIVE && !slave_pool.GetActiveTask(iter->first))
-				{ //    ,      -   
-					iter = m_task.erase(iter);
-				}
-				else //      
-					++iter;
-		}
+/// <param name="ID"> -   </param>
+/// <param name="from"> -    </param>
+/// <param name="to"> -   </param>
+void poolThread_manager_t::SetStatus(taskID ID, int from, int to)
+{ //        -    
+	unsigned long long expected = ID * 8 + from;
+	p_status[ID & STATUS_MASK].compare_exchange_strong(expected, ID * 8 + to, std::memory_order_release, std::memory_order_relaxed);
+}
+
+/// <summary>
+///        
+/// </summary>
+void poolThread_manager_t::WakeUp()
+{ //             Work()
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	if (sleeping.load() != 0)
+	{ //     - 
+		std::lock_guard<std::mutex> lock(mutex);
+		cv_condition.notify_one();
 	}
 }
 
 /// <summary>
-///   
+/// 
 /// </summary>
-poolThread_manager_t::poolThread_manager_t(const size_t SIZE) : slave_pool(cv_condition, mutex, SIZE), counter(0), master_thread([this]() { Update(); }), stop(false)
+/// <param name="SIZE"> -    </param>
+/// <param name="QUEUE_SIZE"> -    ,           </param>
+/// <param name="workStealing"> - 1 -   ,       QUEUE_SIZE </param>
+poolThread_manager_t::poolThread_manager_t(const size_t SIZE, const size_t QUEUE_SIZE, const bool workStealing) :
+	poolThread_manager_t(SIZE, SIZE, std::chrono::microseconds(0), std::chrono::milliseconds(0), QUEUE_SIZE, workStealing)
 {}
 
+/// <summary>
+///   
+/// </summary>
+/// <param name="MIN_SIZE"> -  ,     (  1) </param>
+/// <param name="MAX_SIZE"> -    </param>
+/// <param name="waitTarget"> -        </param>
+/// <param name="idleTimeOut"> -   MIN_SIZE,     ,  </param>
+/// <param name="QUEUE_SIZE"> -     </param>
+/// <param name="workStealing"> - 1 -    </param>
+poolThread_manager_t::poolThread_manager_t(const size_t MIN_SIZE, const size_t MAX_SIZE, std::chrono::microseconds waitTarget, std::chrono::milliseconds idleTimeOut,
+	const size_t QUEUE_SIZE, const bool workStealing) : queue(QUEUE_SIZE), overflowSize(0),
+	STATUS_MASK(queue.Capacity() * 2 - 1), p_status(new std::atomic<unsigned long long>[STATUS_MASK + 1]), counter(0), sleeping(0), stop(false),
+	workStealing(workStealing), MIN_SIZE(MIN_SIZE != 0 ? MIN_SIZE : 1), MAX_SIZE(MAX_SIZE > this->MIN_SIZE ? MAX_SIZE : this->MIN_SIZE),
+	WAIT_TARGET(std::chrono::duration_cast<std::chrono::nanoseconds>(waitTarget).count()), IDLE_TIMEOUT(idleTimeOut),
+	active(0), avgWait(0), lastPop(Now()), lastGrow(0), placement(placement_t::NONE), placementGen(0), deadlineSlack(1000000), expiredCount(0)
+{
+	for (int index = 0; index < priority_t::COUNT; ++index)
+		scheduledSize[index].store(0, std::memory_order_relaxed);
+
+	for (size_t index = 0; index <= STATUS_MASK; ++index)
+		p_status[index].store(0, std::memory_order_relaxed);
+
+	v_worker.reserve(this->MAX_SIZE);
+	for (size_t index = 0; index < this->MAX_SIZE; ++index) //       -   
+		v_worker.push_back(std::unique_ptr<worker_t>(new worker_t(this, workStealing ? QUEUE_SIZE : 1, unsigned(index))));
+
+	if (cpuTopology_t::Get().NodeCount() > 1) //    :      
+		for (size_t node = 0; node < cpuTopology_t::Get().NodeCount(); ++node)
+			v_nodeQueue.push_back(std::unique_ptr<mpmcQueue_t<queuedTask_t>>(new mpmcQueue_t<queuedTask_t>(QUEUE_SIZE)));
+
+	v_thread.resize(this->MAX_SIZE);
+	for (size_t index = 0; index < this->MIN_SIZE; ++index)
+	{
+		v_worker[index]->running.store(true);
+		active.fetch_add(1);
+		v_thread[index] = std::thread([this, index]() { Work(*v_worker[index]); });
+	}
+}
+
 /// <summary>
 /// 
 /// </summary>
 poolThread_manager_t::~poolThread_manager_t()
-{   //     
+{   //     
 	stop = true;
-	mutex.lock(); //  ,   
-	cv_condition.notify_one();
+	mutex.lock(); //  ,   
+	cv_condition.notify_all();
 	mutex.unlock();
 
-	master_thread.join(); //   
+	std::lock_guard<std::mutex> lock(mtx_resize); //      
+	for (size_t index = 0; index < v_thread.size(); ++index)
+		if (v_thread[index].joinable()) //      
+			v_thread[index].join(); //   
+
+	//   :   ,    .
+	//      ,    Submit    
+	for (size_t index = 0; index < v_worker.size(); ++index)
+		while (queuedTask_t* p_task = v_worker[index]->deque.Pop()) //        
+		{
+			Cancel(std::move(p_task->p_future));
+			FreeLocal(*v_worker[index], p_task);
+		}
+
+	queuedTask_t task;
+	while (queue.TryPop(task))
+		Cancel(std::move(task.p_future));
+	for (size_t node = 0; node < v_nodeQueue.size(); ++node)
+		while (v_nodeQueue[node]->TryPop(task))
+			Cancel(std::move(task.p_future));
+	for (size_t index = 0; index < d_overflow.size(); ++index)
+		Cancel(std::move(d_overflow[index].p_future));
+	for (int priority = 0; priority < priority_t::COUNT; ++priority)
+		for (size_t index = 0; index < v_scheduled[priority].size(); ++index)
+			Cancel(std::move(v_scheduled[priority][index].p_future));
 }
 
 /// <summary>
@@ -234,37 +504,409 @@ poolThread_manager_t::~poolThread_manager_t()
 /// <param name="p_task"> - smart_ptr    </param>
 /// <returns>      () </returns>
 taskID poolThread_manager_t::AddTask(std::shared_ptr<ABStask> p_task)
+{
+	return Submit(p_task, nullptr);
+}
+
+/// <summary>
+///       
+/// </summary>
+/// <param name="p_task"> - smart_ptr    </param>
+/// <param name="future"> -    </param>
+/// <returns>      () </returns>
+taskID poolThread_manager_t::AddTask(std::shared_ptr<ABStask> p_task, taskFuture_t& future)
+{
+	future.p_state = std::make_shared<futureState_t>(this);
+	return Submit(p_task, future.p_state);
+}
+
+/// <summary>
+///         
+/// </summary>
+/// <param name="p_task"> - smart_ptr    </param>
+/// <param name="priority"> -  priority_t </param>
+/// <param name="deadline"> -    </param>
+/// <returns>      () </returns>
+taskID poolThread_manager_t::AddTask(std::shared_ptr<ABStask> p_task, int priority, std::chrono::steady_clock::time_point deadline)
+{
+	return Submit(p_task, nullptr, priority, DeadlineOf(deadline));
+}
+
+/// <summary>
+///       ,    
+/// </summary>
+/// <param name="p_task"> - smart_ptr    </param>
+/// <param name="future"> -    </param>
+/// <param name="priority"> -  priority_t </param>
+/// <param name="deadline"> -    </param>
+/// <returns>      () </returns>
+taskID poolThread_manager_t::AddTask(std::shared_ptr<ABStask> p_task, taskFuture_t& future, int priority, std::chrono::steady_clock::time_point deadline)
+{
+	future.p_state = std::make_shared<futureState_t>(this);
+	return Submit(p_task, future.p_state, priority, DeadlineOf(deadline));
+}
+
+/// <summary>
+///       
+/// </summary>
+/// <param name="deadline"> - , time_point::max() -   </param>
+/// <returns>   , 0 -   </returns>
+long long poolThread_manager_t::DeadlineOf(std::chrono::steady_clock::time_point deadline)
+{
+	if (deadline == std::chrono::steady_clock::time_point::max())
+		return 0;
+
+	long long result = std::chrono::duration_cast<std::chrono::nanoseconds>(deadline.time_since_epoch()).count();
+	return result > 0 ? result : 1; //       , 0   " "
+}
+
+/// <summary>
+///    (  AddTask  )
+/// </summary>
+/// <param name="p_task"> -  </param>
+/// <param name="p_future"> -    , nullptr -    </param>
+/// <param name="priority"> -  priority_t </param>
+/// <param name="deadline"> -       , 0 -   </param>
+/// <returns>    </returns>
+taskID poolThread_manager_t::Submit(std::shared_ptr<ABStask> p_task, std::shared_ptr<futureState_t> p_future, int priority, long long deadline)
 {
 	taskID result = ++counter;
-	//     
-	std::lock_guard<std::mutex> lock(mutex);
-	m_task[result].p_task = p_task;
-	m_task[result].status = EXCEPTION;
-	cv_condition.notify_one(); //   
+	if (stop)
+	{ //   (  ) -   ,  
+		Cancel(std::move(p_future));
+		return result;
+	}
+	queuedTask_t task;
+	task.ID = result;
+	task.p_task = p_task;
+	task.p_future = std::move(p_future);
+	task.deadline = deadline;
+	if (priority < priority_t::HIGH || priority >= priority_t::COUNT)
+		priority = priority_t::NORMAL;
+	long long now = 0;
+	if (MAX_SIZE > MIN_SIZE)
+		task.queued = now = Now();
+	//    :        
+	p_status[result & STATUS_MASK].store(result * 8 + EXCEPTION, std::memory_order_release);
+
+	bool pushed = false;
+	if (priority != priority_t::NORMAL || deadline != 0)
+	{ //      -    ,   
+		std::lock_guard<std::mutex> lock(mtx_scheduled);
+		v_scheduled[priority].push_back(std::move(task));
+		std::push_heap(v_scheduled[priority].begin(), v_scheduled[priority].end(), laterTask_t());
+		scheduledSize[priority].store(v_scheduled[priority].size(), std::memory_order_release);
+		pushed = true;
+	}
+
+	if (!pushed && workStealing && p_currentWorker != nullptr && p_currentWorker->owner == this)
+	{ //      -       ,       
+		queuedTask_t* p_local = new (p_currentWorker->taskSlab.Allocate(sizeof(queuedTask_t))) queuedTask_t(std::move(task));
+		pushed = p_currentWorker->deque.Push(p_local);
+		if (!pushed)
+		{
+			task = std::move(*p_local);
+			FreeLocal(*p_currentWorker, p_local);
+		}
+	}
+
+	if (!pushed && !v_nodeQueue.empty() && placement.load(std::memory_order_relaxed) != placement_t::NONE)
+	{ //    ,    :       
+		int node = (p_currentWorker != nullptr && p_currentWorker->owner == this) ? p_currentWorker->node.load(std::memory_order_relaxed)
+			: cpuTopology_t::CurrentNode();
+		if (node >= 0 && node < int(v_nodeQueue.size()))
+			pushed = v_nodeQueue[node]->TryPush(task);
+	}
+
+	if (!pushed && !queue.TryPush(task))
+	{ //   -   ,    
+		std::lock_guard<std::mutex> lock(mtx_overflow);
+		d_overflow.push_back(std::move(task));
+		overflowSize.fetch_add(1, std::memory_order_release);
+	}
+	WakeUp();
+	//           -      ,
+	//  ,    , 
+	if (MAX_SIZE > MIN_SIZE && now - lastPop.load(std::memory_order_relaxed) > WAIT_TARGET)
+		CheckGrow(now);
 
 	return result;
 }
 
 /// <summary>
-///    
+///    .      ;     , 
+/// ,     ,      -    (EVICTED), 
+///     taskFuture_t
 /// </summary>
 /// <param name="ID"></param>
 /// <returns> NON_DEFINE (0) -  ( taskID)
 ///           ACTIVE (1) -     
 ///           COMPLECTED (2) -  
-///           EXCEPTION (3) -       </returns>
+///           EXCEPTION (3) -     
+///           EXPIRED (4) -   ,    
+///           EVICTED (5) -    ,     ,      </returns>
 int poolThread_manager_t::GetStatusTask(taskID ID)
 {
 	int result = NON_DEFINE;
 
-	if (ID < counter)
+	if (ID != 0 && ID <= counter.load())
 	{   //   
-		std::lock_guard<std::mutex> lock(mutex);
-		if (m_task.find(ID) != m_task.end()) //  
-			result = m_task[ID].status;
-		else //    -   
-			result = COMPLECTED;
+		unsigned long long status = p_status[ID & STATUS_MASK].load(std::memory_order_acquire);
+		if (status / 8 == ID) //     
+			result = int(status % 8);
+		else //      -   ,          
+			result = EVICTED;
 	}
 
 	return result;
 }
+
+/// <summary>
+///     
+/// </summary>
+/// <returns>   </returns>
+size_t poolThread_manager_t::GetThreadCount() const
+{
+	return active.load();
+}
+
+/// <summary>
+///         ( ,     )
+/// </summary>
+/// <returns>    </returns>
+std::chrono::microseconds poolThread_manager_t::GetQueueWait() const
+{
+	return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::nanoseconds(avgWait.load(std::memory_order_relaxed)));
+}
+
+/// <summary>
+///      
+/// </summary>
+/// <param name="policy"> -  placement_t (CORE -    , NODE -    ) </param>
+void poolThread_manager_t::SetPlacement(int policy)
+{
+	placement.store(policy, std::memory_order_relaxed);
+	placementGen.fetch_add(1, std::memory_order_release);
+	//      ,   
+	std::lock_guard<std::mutex> lock(mutex);
+	cv_condition.notify_all();
+}
+
+/// <summary>
+///      
+/// </summary>
+/// <returns>  placement_t </returns>
+int poolThread_manager_t::GetPlacement() const
+{
+	return placement.load(std::memory_order_relaxed);
+}
+
+/// <summary>
+///     : ,       ,    
+/// </summary>
+/// <param name="slack"> -  </param>
+void poolThread_manager_t::SetDeadlineSlack(std::chrono::microseconds slack)
+{
+	deadlineSlack.store(std::chrono::duration_cast<std::chrono::nanoseconds>(slack).count(), std::memory_order_relaxed);
+}
+
+/// <summary>
+///    ,    
+/// </summary>
+/// <returns>    </returns>
+unsigned long long poolThread_manager_t::GetExpiredCount() const
+{
+	return expiredCount.load(std::memory_order_relaxed);
+}
+
+/// <summary>
+///   :        .     
+/// </summary>
+void futureState_t::Complete()
+{
+	std::vector<std::function<void()>> v_run;
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		if (done.load(std::memory_order_relaxed))
+			return;
+		done.store(true, std::memory_order_release);
+		v_run.swap(v_next);
+	}
+	cv_done.notify_all();
+
+	for (size_t index = 0; index < v_run.size(); ++index) //  :      
+		v_run[index]();
+}
+
+/// <summary>
+///   .    ,      
+/// </summary>
+/// <param name="next"> -  </param>
+void futureState_t::OnComplete(std::function<void()> next)
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		if (!done.load(std::memory_order_relaxed))
+		{
+			v_next.push_back(std::move(next));
+			return;
+		}
+	}
+	next();
+}
+
+/// <summary>
+///    (   )
+/// </summary>
+taskFuture_t::taskFuture_t()
+{}
+
+/// <summary>
+///   
+/// </summary>
+/// <param name="p_state"> -   </param>
+taskFuture_t::taskFuture_t(std::shared_ptr<futureState_t> p_state) : p_state(std::move(p_state))
+{}
+
+/// <summary>
+///     
+/// </summary>
+/// <returns> 1 -     </returns>
+bool taskFuture_t::Valid() const
+{
+	return p_state != nullptr;
+}
+
+/// <summary>
+///     
+/// </summary>
+/// <returns> 1 -   </returns>
+bool taskFuture_t::Ready() const
+{
+	return p_state != nullptr && p_state->done.load(std::memory_order_acquire);
+}
+
+/// <summary>
+///      
+/// </summary>
+/// <returns> 1 -       </returns>
+bool taskFuture_t::Expired() const
+{
+	return Ready() && p_state->expired.load(std::memory_order_relaxed);
+}
+
+/// <summary>
+///       
+/// </summary>
+/// <returns> 1 -      </returns>
+bool taskFuture_t::Cancelled() const
+{
+	return Ready() && p_state->cancelled.load(std::memory_order_relaxed);
+}
+
+/// <summary>
+///    
+/// </summary>
+void taskFuture_t::Wait() const
+{
+	if (p_state != nullptr && !p_state->done.load(std::memory_order_acquire))
+	{
+		std::unique_lock<std::mutex> lock(p_state->mutex);
+		p_state->cv_done.wait(lock, [this]() { return p_state->done.load(std::memory_order_acquire); });
+	}
+}
+
+/// <summary>
+///      
+/// </summary>
+/// <param name="timeOut"> -   </param>
+/// <returns> 1 -   </returns>
+bool taskFuture_t::WaitFor(std::chrono::milliseconds timeOut) const
+{
+	if (p_state == nullptr)
+		return false;
+
+	if (!p_state->done.load(std::memory_order_acquire))
+	{
+		std::unique_lock<std::mutex> lock(p_state->mutex);
+		return p_state->cv_done.wait_for(lock, timeOut, [this]() { return p_state->done.load(std::memory_order_acquire); });
+	}
+
+	return true;
+}
+
+/// <summary>
+///  :          ( ,  )
+/// </summary>
+/// <param name="p_task"> -   </param>
+/// <returns>   ; ,     </returns>
+taskFuture_t taskFuture_t::Then(std::shared_ptr<ABStask> p_task) const
+{
+	if (p_state == nullptr || p_state->p_pool == nullptr)
+		return taskFuture_t();
+
+	std::shared_ptr<futureState_t> p_next = std::make_shared<futureState_t>(p_state->p_pool);
+	poolThread_manager_t* p_pool = p_state->p_pool;
+	p_state->OnComplete([p_pool, p_task, p_next]() { p_pool->Submit(p_task, p_next); });
+
+	return taskFuture_t(p_next);
+}
+
+/// <summary>
+///      -   
+/// </summary>
+poolThread_manager_t* taskFuture_t::PoolOf(const std::vector<taskFuture_t>& v_futures)
+{
+	for (size_t index = 0; index < v_futures.size(); ++index)
+		if (v_futures[index].p_state != nullptr)
+			return v_futures[index].p_state->p_pool;
+
+	return nullptr;
+}
+
+/// <summary>
+///  :  ,    
+/// </summary>
+/// <param name="v_futures"> -   ( ) </param>
+/// <returns>  ,   -   </returns>
+taskFuture_t taskFuture_t::WhenAll(const std::vector<taskFuture_t>& v_futures)
+{
+	std::shared_ptr<futureState_t> p_all = std::make_shared<futureState_t>(PoolOf(v_futures));
+	//    ,    ,     
+	std::shared_ptr<std::atomic<size_t>> p_left = std::make_shared<std::atomic<size_t>>(1);
+
+	for (size_t index = 0; index < v_futures.size(); ++index)
+		if (v_futures[index].p_state != nullptr)
+		{
+			p_left->fetch_add(1);
+			v_futures[index].p_state->OnComplete([p_all, p_left]() { if (p_left->fetch_sub(1) == 1) p_all->Complete(); });
+		}
+
+	if (p_left->fetch_sub(1) == 1)
+		p_all->Complete();
+
+	return taskFuture_t(p_all);
+}
+
+/// <summary>
+///  :  ,     
+/// </summary>
+/// <param name="v_futures"> -   ( ) </param>
+/// <returns>  ,   -   </returns>
+taskFuture_t taskFuture_t::WhenAny(const std::vector<taskFuture_t>& v_futures)
+{
+	std::shared_ptr<futureState_t> p_any = std::make_shared<futureState_t>(PoolOf(v_futures));
+	bool empty = true;
+
+	for (size_t index = 0; index < v_futures.size(); ++index)
+		if (v_futures[index].p_state != nullptr)
+		{ // Complete    -    
+			empty = false;
+			v_futures[index].p_state->OnComplete([p_any]() { p_any->Complete(); });
+		}
+
+	if (empty)
+		p_any->Complete();
+
+	return taskFuture_t(p_any);
+}
@@ -4,10 +4,20 @@
 
 #include <thread>
 #include <atomic>
-#include <map>
+#include <deque>
 #include <mutex>
+#include <condition_variable>
 #include <vector>
 #include <memory>
+#include <chrono>
+#include <functional>
+#include <system_error>
+#include <climits>
+
+#include "mpmcQueue.h"
+#include "wsDeque.h"
+#include "slab.h"
+#include "topology.h"
 
 typedef unsigned long long taskID; //  
 
@@ -25,156 +35,368 @@ public:
     virtual ~ABStask() {}
 };
 
+//     
+#define NON_DEFINE 0 //  ( taskID)
+#define ACTIVE 1 //     
+#define COMPLECTED 2 //  
+#define EXCEPTION 3 //      
+#define EXPIRED 4 //      ,  
+#define EVICTED 5 //  :       
+
 /// <summary>
-///    
+///    
 /// </summary>
-class task_t
+struct priority_t
 {
-    friend struct thread_t;
-    friend class poolThread_t;
-protected :
+    static const int HIGH = 0; //   ( ),  
+    static const int NORMAL = 1; //  ,  AddTask  
+    static const int LOW = 2; //   ( ),   ,    
+    static const int COUNT = 3; //  
+};
+
+class poolThread_manager_t;
+
+/// <summary>
+///       (taskFuture_t).     ,
+///         
+/// </summary>
+struct futureState_t
+{
+    futureState_t(poolThread_manager_t* p_pool) : done(false), expired(false), cancelled(false), p_pool(p_pool)
+    {}
+
     /// <summary>
-    /// 
+    ///   :        .     
     /// </summary>
-    /// <param name="cv_wakeUp"> -          </param>
-    /// <param name="mtx_wakeUp"> -     </param>
-    task_t(std::condition_variable& cv_wakeUp, std::mutex& mtx_wakeUp);
+    void Complete();
 
     /// <summary>
-    ///   .    
+    ///   .    ,      
     /// </summary>
-    void Work();
+    /// <param name="next"> -  </param>
+    void OnComplete(std::function<void()> next);
 
+    std::atomic_bool done; //  
+    std::atomic_bool expired; //     ,  
+    std::atomic_bool cancelled; //     ,  
+    std::mutex mutex; //     
+    std::condition_variable cv_done; //    
+    std::vector<std::function<void()>> v_next; // ,     
+    poolThread_manager_t* p_pool; // ,     
+};
+
+/// <summary>
+///     : ,         .
+///     .     ,   
+/// ,     
+/// </summary>
+class taskFuture_t
+{
+    friend class poolThread_manager_t; //    AddTask
+public:
     /// <summary>
-    ///   
+    ///    (   )
     /// </summary>
-    /// <param name="userTask"> -      </param>
-    /// <returns> 1 -   </returns>
-    bool UpdateTask(std::shared_ptr<ABStask> userTask);
+    taskFuture_t();
 
     /// <summary>
-    ///   
+    ///     
     /// </summary>
-    /// <returns> 1 -   </returns>
-    bool GetActive() const;
+    /// <returns> 1 -     </returns>
+    bool Valid() const;
 
     /// <summary>
-    ///     
+    ///     
     /// </summary>
-    void Stop();
+    /// <returns> 1 -   </returns>
+    bool Ready() const;
 
-    virtual ~task_t();
-protected:
-    std::condition_variable cv_condition; //        
-    mutable std::mutex mutex;//     
-    std::condition_variable& cv_wakeUp; //          
-    std::mutex& mtx_wakeUp; //      
-    volatile std::atomic_bool b_stop; //    
-    volatile std::atomic_bool b_active; //    
-
-    std::shared_ptr<ABStask> p_userTask; //    
-};
+    /// <summary>
+    ///      :     (   ),
+    ///   Work  
+    /// </summary>
+    /// <returns> 1 -       </returns>
+    bool Expired() const;
 
-/// <summary>
-///      
-/// </summary>
-struct thread_t
-{
-    friend class poolThread_t;
- 
     /// <summary>
-    ///   
+    ///       : ,      ,  ,
+    ///   ,   ,    
     /// </summary>
-    thread_t(std::condition_variable& cv_wakeUp, std::mutex& mtx_wakeUp);
-    ///
-    virtual ~thread_t();
+    /// <returns> 1 -      </returns>
+    bool Cancelled() const;
 
-protected :
-    std::thread thread; //  
-    task_t task; // 
-};
+    /// <summary>
+    ///    
+    /// </summary>
+    void Wait() const;
 
+    /// <summary>
+    ///      
+    /// </summary>
+    /// <param name="timeOut"> -   </param>
+    /// <returns> 1 -   </returns>
+    bool WaitFor(std::chrono::milliseconds timeOut) const;
 
-/// <summary>
-///   
-/// </summary>
-class poolThread_t
-{
-    friend class poolThread_manager_t;
-protected :
     /// <summary>
-    /// 
+    ///  :          ( ,  )
     /// </summary>
-    /// <param name="cv_wakeUp"> -     -     </param>
-    /// <param name="mtx_wakeUp"> -    </param>
-    poolThread_t(std::condition_variable& cv_wakeUp, std::mutex& mtx_wakeUp, const size_t SIZE); 
+    /// <param name="p_task"> -   </param>
+    /// <returns>   ; ,     </returns>
+    taskFuture_t Then(std::shared_ptr<ABStask> p_task) const;
 
-    virtual ~poolThread_t()
-    {}
+    /// <summary>
+    ///  :  ,    
+    /// </summary>
+    /// <param name="v_futures"> -   ( ) </param>
+    /// <returns>  ,   -   </returns>
+    static taskFuture_t WhenAll(const std::vector<taskFuture_t>& v_futures);
 
     /// <summary>
-    ///   
+    ///  :  ,     
     /// </summary>
-    /// <param name="userTask"> -      </param>
-    /// <returns> INVALID_TASK -   ; ID>INVALID_TASK - ID  </returns>
-    bool UpdateTask(std::shared_ptr<ABStask> userTask, taskID ID);
-    
+    /// <param name="v_futures"> -   ( ) </param>
+    /// <returns>  ,   -   </returns>
+    static taskFuture_t WhenAny(const std::vector<taskFuture_t>& v_futures);
+
+protected:
     /// <summary>
-    ///    
+    ///   
     /// </summary>
-    /// <param name="ID"> - ID   </param>
-    /// <returns> 1 -   </returns>
-    bool GetActiveTask(taskID ID);
+    /// <param name="p_state"> -   </param>
+    explicit taskFuture_t(std::shared_ptr<futureState_t> p_state);
 
     /// <summary>
-    ///     
+    ///      -   
     /// </summary>
-    /// <returns> 1 -       </returns>
-    bool GetFree() const;
+    static poolThread_manager_t* PoolOf(const std::vector<taskFuture_t>& v_futures);
 
-protected:
-    std::vector<std::shared_ptr<thread_t>> v_thread; //  
-    std::vector<taskID> v_taskID; //  ID 
-    const size_t SIZE; //  
-    mutable bool free; //    
+    std::shared_ptr<futureState_t> p_state; //  , nullptr -  
 };
 
-//     
-#define NON_DEFINE 0 //  ( taskID)
-#define ACTIVE 1 //     
-#define COMPLECTED 2 //  
-#define EXCEPTION 3 //      
-
 /// <summary>
-///      
+///        
 /// </summary>
-struct status_p_task_t
+struct queuedTask_t
 {
-    friend class poolThread_manager_t;
-    status_p_task_t() : status(0), p_task(nullptr)
+    queuedTask_t() : ID(0), p_task(nullptr), queued(0), deadline(0)
     {}
-protected :
-    char status; //  
+    taskID ID; //  
     std::shared_ptr<ABStask> p_task; //   
+    std::shared_ptr<futureState_t> p_future; //    , nullptr -   
+    long long queued; //     (   )
+    long long deadline; //       , 0 -  
 };
 
 /// <summary>
-///   ,        
+///   ,        .
+///       ,      -   .
+///        : ,   ABStask::Work,   
+///  ,         .
+///     MIN_SIZE  MAX_SIZE :  ,     
+///    ,   ,     .
+///      NUMA (SetPlacement)     :     ,
+///       (,  ,  ),   
+///  ;    ,       .
+///      (AddTask  priority_t)       ,   .
+///    ,   ,     HIGH, NORMAL, LOW;  NORMAL_TURN-
+///     NORMAL,  LOW_TURN- -  LOW,      
+///  .       
 /// </summary>
 class poolThread_manager_t
 {
+    friend class taskFuture_t; //     Submit
 protected:
-    
     /// <summary>
-    ///    
+    ///   
+    /// </summary>
+    struct worker_t
+    {
+        worker_t(poolThread_manager_t* owner, size_t capacity, unsigned index) : owner(owner), taskSlab(sizeof(queuedTask_t), capacity < 256 ? capacity : 256),
+            deque(capacity), seed(index * 2654435761u + 1), running(false), index(index), node(-1), placed(0), turn(0)
+        {}
+        poolThread_manager_t* owner; // ,   
+        slabPool_t taskSlab; //   :    ,    
+        wsDeque_t<queuedTask_t> deque; //    ( ),   taskSlab
+        unsigned seed; //      
+        std::atomic_bool running; //    (       )
+        const unsigned index; //  ,      
+        std::atomic<int> node; //  NUMA,    , -1 -   
+        unsigned placed; //   ,  
+        unsigned turn; //   ,       
+    };
+
+    /// <summary>
+    ///     :   -  ,    -       
+    /// </summary>
+    struct laterTask_t
+    {
+        bool operator () (const queuedTask_t& left, const queuedTask_t& right) const
+        {
+            long long leftKey = left.deadline != 0 ? left.deadline : LLONG_MAX;
+            long long rightKey = right.deadline != 0 ? right.deadline : LLONG_MAX;
+            return leftKey > rightKey || (leftKey == rightKey && left.ID > right.ID);
+        }
+    };
+
+    static const unsigned NORMAL_TURN = 4; //  NORMAL_TURN-     NORMAL
+    static const unsigned LOW_TURN = 16; //  LOW_TURN-     LOW
+
+    /// <summary>
+    ///    
+    /// </summary>
+    /// <param name="worker"> -   </param>
+    void Work(worker_t& worker);
+
+    /// <summary>
+    ///   :   ,    
+    /// </summary>
+    /// <param name="task"> -   </param>
+    /// <returns> 1 -   </returns>
+    bool Pop(queuedTask_t& task);
+
+    /// <summary>
+    ///      :  ,  ,  
+    /// </summary>
+    /// <param name="worker"> -   </param>
+    /// <param name="task"> -   </param>
+    /// <returns> 1 -   </returns>
+    bool PopStealing(worker_t& worker, queuedTask_t& task);
+
+    /// <summary>
+    ///    ,   ,     
+    /// </summary>
+    /// <param name="owner"> - ,       </param>
+    /// <param name="p_task"> -   </param>
+    static void FreeLocal(worker_t& owner, queuedTask_t* p_task);
+
+    /// <summary>
+    ///       NUMA
+    /// </summary>
+    /// <param name="worker"> -   </param>
+    /// <param name="task"> -   </param>
+    /// <param name="own"> - 1 -    ; 0 -    </param>
+    /// <returns> 1 -   </returns>
+    bool PopNode(worker_t& worker, queuedTask_t& task, bool own);
+
+    /// <summary>
+    ///         
+    /// </summary>
+    /// <param name="worker"> -   </param>
+    /// <param name="task"> -   </param>
+    /// <returns> 1 -   </returns>
+    bool PopTask(worker_t& worker, queuedTask_t& task);
+
+    /// <summary>
+    ///      .       
+    /// </summary>
+    /// <param name="task"> -   </param>
+    /// <param name="priority"> -  priority_t; -1 -   ,    </param>
+    /// <returns> 1 -   </returns>
+    bool PopScheduled(queuedTask_t& task, int priority);
+
+    /// <summary>
+    ///      :  EXPIRED,      
+    /// </summary>
+    /// <param name="task"> -   </param>
+    void Expire(queuedTask_t& task);
+
+    /// <summary>
+    ///      :      
+    /// </summary>
+    /// <param name="p_future"> -   , nullptr -    </param>
+    static void Cancel(std::shared_ptr<futureState_t> p_future);
+
+    /// <summary>
+    ///        
+    /// </summary>
+    /// <param name="worker"> -   </param>
+    void Place(worker_t& worker);
+
+    /// <summary>
+    ///       
+    /// </summary>
+    /// <returns> 1 -         </returns>
+    bool HasTasks() const;
+
+    /// <summary>
+    ///       
+    /// </summary>
+    /// <param name="ID"> -   </param>
+    /// <param name="from"> -    </param>
+    /// <param name="to"> -   </param>
+    void SetStatus(taskID ID, int from, int to);
+
+    /// <summary>
+    ///        
     /// </summary>
-    void Update();
-   
+    void WakeUp();
+
+    /// <summary>
+    ///    (  AddTask  )
+    /// </summary>
+    /// <param name="p_task"> -  </param>
+    /// <param name="p_future"> -    , nullptr -    </param>
+    /// <param name="priority"> -  priority_t </param>
+    /// <param name="deadline"> -       , 0 -   </param>
+    /// <returns>    </returns>
+    taskID Submit(std::shared_ptr<ABStask> p_task, std::shared_ptr<futureState_t> p_future, int priority = priority_t::NORMAL, long long deadline = 0);
+
+    /// <summary>
+    ///       
+    /// </summary>
+    /// <param name="deadline"> - , time_point::max() -   </param>
+    /// <returns>   , 0 -   </returns>
+    static long long DeadlineOf(std::chrono::steady_clock::time_point deadline);
+
+    /// <summary>
+    ///           
+    /// </summary>
+    /// <param name="task"> -   </param>
+    void MeasureWait(const queuedTask_t& task);
+
+    /// <summary>
+    ///    ,    ,        
+    /// </summary>
+    /// <param name="now"> -     </param>
+    void CheckGrow(long long now);
+
+    /// <summary>
+    ///       
+    /// </summary>
+    /// <returns> 1 -   </returns>
+    bool Grow();
+
+    /// <summary>
+    ///      
+    /// </summary>
+    /// <returns>      </returns>
+    static long long Now();
+
 public:
     /// <summary>
-    ///   
+    /// 
     /// </summary>
-    poolThread_manager_t(const size_t SIZE);
+    /// <param name="SIZE"> -    </param>
+    /// <param name="QUEUE_SIZE"> -    ,           </param>
+    /// <param name="workStealing"> - 1 -   ,       QUEUE_SIZE </param>
+    poolThread_manager_t(const size_t SIZE, const size_t QUEUE_SIZE = 1024, const bool workStealing = false);
+
+    /// <summary>
+    ///   
+    /// </summary>
+    /// <param name="MIN_SIZE"> -  ,     (  1) </param>
+    /// <param name="MAX_SIZE"> -    </param>
+    /// <param name="waitTarget"> -       :      
+    ///       ,         </param>
+    /// <param name="idleTimeOut"> -   MIN_SIZE,     ,  </param>
+    /// <param name="QUEUE_SIZE"> -     </param>
+    /// <param name="workStealing"> - 1 -    </param>
+    poolThread_manager_t(const size_t MIN_SIZE, const size_t MAX_SIZE, std::chrono::microseconds waitTarget, std::chrono::milliseconds idleTimeOut,
+        const size_t QUEUE_SIZE = 1024, const bool workStealing = false);
+
+    //  -   
+    poolThread_manager_t(const poolThread_manager_t& pool) = delete;
+    poolThread_manager_t& operator = (const poolThread_manager_t& pool) = delete;
 
     /// <summary>
     /// 
@@ -182,30 +404,129 @@ public:
     virtual ~poolThread_manager_t();
 
     /// <summary>
-    ///    
+    ///    .    ,      ,
+    ///    ,    -   
     /// </summary>
     /// <param name="p_task"> - smart_ptr    </param>
     /// <returns>      () </returns>
     taskID AddTask(std::shared_ptr<ABStask> p_task);
 
     /// <summary>
-    ///    
+    ///       :     
+    ///  (taskFuture_t::Then)   GetStatusTask
+    /// </summary>
+    /// <param name="p_task"> - smart_ptr    </param>
+    /// <param name="future"> -    </param>
+    /// <returns>      () </returns>
+    taskID AddTask(std::shared_ptr<ABStask> p_task, taskFuture_t& future);
+
+    /// <summary>
+    ///         . ,    ,   
+    /// ( EXPIRED); ,  -  (. SetDeadlineSlack),     
+    /// </summary>
+    /// <param name="p_task"> - smart_ptr    </param>
+    /// <param name="priority"> -  priority_t </param>
+    /// <param name="deadline"> -   ,     </param>
+    /// <returns>      () </returns>
+    taskID AddTask(std::shared_ptr<ABStask> p_task, int priority,
+        std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::time_point::max());
+
+    /// <summary>
+    ///       ,    .    
+    ///  , taskFuture_t::Expired() ,    
+    /// </summary>
+    /// <param name="p_task"> - smart_ptr    </param>
+    /// <param name="future"> -    </param>
+    /// <param name="priority"> -  priority_t </param>
+    /// <param name="deadline"> -   ,     </param>
+    /// <returns>      () </returns>
+    taskID AddTask(std::shared_ptr<ABStask> p_task, taskFuture_t& future, int priority,
+        std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::time_point::max());
+
+    /// <summary>
+    ///    .      ;     , 
+    /// ,     ,      -    (EVICTED), 
+    ///     taskFuture_t
     /// </summary>
     /// <param name="ID"></param>
     /// <returns> NON_DEFINE (0) -  ( taskID)
     ///           ACTIVE (1) -     
     ///           COMPLECTED (2) -  
-    ///           EXCEPTION (3) -       </returns>
+    ///           EXCEPTION (3) -     
+    ///           EXPIRED (4) -   ,    
+    ///           EVICTED (5) -    ,     ,      </returns>
     int GetStatusTask(taskID ID);
 
+    /// <summary>
+    ///     
+    /// </summary>
+    /// <returns>   </returns>
+    size_t GetThreadCount() const;
+
+    /// <summary>
+    ///         ( ,     )
+    /// </summary>
+    /// <returns>    </returns>
+    std::chrono::microseconds GetQueueWait() const;
+
+    /// <summary>
+    ///      .       ;
+    ///  ,   NONE,    NUMA        
+    /// </summary>
+    /// <param name="policy"> -  placement_t (CORE -    , NODE -    ) </param>
+    void SetPlacement(int policy);
+
+    /// <summary>
+    ///      
+    /// </summary>
+    /// <returns>  placement_t </returns>
+    int GetPlacement() const;
+
+    /// <summary>
+    ///     : ,       ,    
+    /// </summary>
+    /// <param name="slack"> -  (  1 ) </param>
+    void SetDeadlineSlack(std::chrono::microseconds slack);
+
+    /// <summary>
+    ///    ,    
+    /// </summary>
+    /// <returns>    </returns>
+    unsigned long long GetExpiredCount() const;
+
 protected :
-    poolThread_t slave_pool; //   
-    taskID counter; // 
-    std::map<taskID, status_p_task_t> m_task; //          
-    std::thread master_thread; //  ,   ,    
-    std::condition_variable cv_condition; //  ,      
-    mutable std::mutex mutex;//  -   
+    mpmcQueue_t<queuedTask_t> queue; //    
+    std::deque<queuedTask_t> d_overflow; //  ,     
+    std::mutex mtx_overflow; //   
+    std::atomic<size_t> overflowSize; //   ,       
+    const size_t STATUS_MASK; //    
+    std::unique_ptr<std::atomic<unsigned long long>[]> p_status; //  :   * 8 + 
+    std::atomic<taskID> counter; // 
+    std::atomic<size_t> sleeping; //    
+    std::condition_variable cv_condition; //         
+    std::mutex mutex;//    
     volatile std::atomic_bool stop; //    
+    const bool workStealing; //   
+    std::vector<std::unique_ptr<worker_t>> v_worker; //   ,   MAX_SIZE 
+    std::vector<std::thread> v_thread; //  ,  mtx_resize
+    const size_t MIN_SIZE; //    
+    const size_t MAX_SIZE; //  ,  MIN_SIZE    
+    const long long WAIT_TARGET; //       
+    const std::chrono::milliseconds IDLE_TIMEOUT; //  ,     
+    std::atomic<size_t> active; //   
+    std::atomic<long long> avgWait; //      
+    std::atomic<long long> lastPop; //      
+    std::atomic<long long> lastGrow; //      
+    std::mutex mtx_resize; //      
+    std::vector<std::unique_ptr<mpmcQueue_t<queuedTask_t>>> v_nodeQueue; //   NUMA (     )
+    std::atomic<int> placement; //    
+    std::atomic<unsigned> placementGen; //  ,    
+    std::vector<queuedTask_t> v_scheduled[priority_t::COUNT]; //         (laterTask_t)
+    std::atomic<size_t> scheduledSize[priority_t::COUNT]; //  ,       
+    std::mutex mtx_scheduled; //   
+    std::atomic<long long> deadlineSlack; //     
+    std::atomic<unsigned long long> expiredCount; //     
+    static thread_local worker_t* p_currentWorker; //   ,     - 
 };
 
 
@@ -0,0 +1,612 @@
+#include "reactor.h"
+
+/// <summary>
+///         ( )
+/// </summary>
+std::shared_ptr<network::socket_t> network::TCP_reactor_t::AsSocket(const std::shared_ptr<TCP_socketClient_t>& socket)
+{ //   ,    ,      
+    return std::shared_ptr<socket_t>(socket, static_cast<socket_t*>(socket.get()));
+}
+
+/// <summary>
+///         ( )
+/// </summary>
+std::shared_ptr<network::socket_t> network::TCP_reactor_t::AsSocket(const std::shared_ptr<TCP_socketServer_t>& socket)
+{
+    return std::shared_ptr<socket_t>(socket, static_cast<socket_t*>(socket.get()));
+}
+
+/// <summary>
+///        
+/// </summary>
+void network::TCP_reactor_t::Accept()
+{
+    int result = 0;
+    //     -   ,   " "
+    while (result == 0)
+    {
+        //          
+        std::shared_ptr<TCP_socketClient_t> client = std::allocate_shared<TCP_socketClient_t>(slabAllocator_t<TCP_socketClient_t>(connPool), logger);
+        if ((result = server->AddClient(*client)) == 0)
+        {
+            int connID = client->getSocket();
+            if (manager.AddReader(AsSocket(client))) // AddReader     
+            {
+                conn_t& conn = m_conn[connID];
+                conn.socket = client;
+                if (p_codec != nullptr)
+                    conn.codec = p_codec->Clone(); //      
+                if (b_zeroCopy)
+                    client->SetZeroCopy(true);
+                handler.OnConnect(connID, client->serverInfo);
+                Read(connID); //     
+            }
+        } // -2 -  ;           
+    }
+}
+
+/// <summary>
+///          
+/// </summary>
+/// <param name="connID"> - ID  </param>
+/// <returns> 1 -  , 0 -    </returns>
+bool network::TCP_reactor_t::Read(int connID)
+{
+    std::map<int, conn_t>::iterator iter = m_conn.find(connID);
+    if (iter == m_conn.end())
+        return false;
+
+    conn_t& conn = iter->second;
+    int result = 0;
+    //    " ",         ;      
+    for (;;)
+    {
+        if (conn.codec != nullptr)
+        {   //      ;       .
+            //   ,     
+            slice_t frame;
+            size_t used = 0;
+            int decode = 0;
+            while (!conn.paused && (decode = conn.codec->Next(conn.buffer.ReadSlice(), frame, used)) > 0)
+            {
+                s_msg.assign(frame.data, frame.size); //  ,     
+                conn.buffer.Consume(used);
+                handler.OnMessage(connID, s_msg);
+            }
+
+            if (decode < 0)
+            {
+                logger.doLog("TCP_reactor_t - invalid frame or message too long, connection closed");
+                CloseConn(connID);
+                return false;
+            }
+        }
+
+        if (!conn.socket->GetConnected())
+        { //      
+            result = -2;
+            break;
+        }
+        if (conn.paused)
+            return true; //    
+        if ((result = conn.socket->Recive(conn.buffer)) <= 0)
+            break;
+
+        if (conn.codec == nullptr)
+        { //    -   ,    
+            slice_t data = conn.buffer.ReadSlice();
+            s_msg.assign(data.data, data.size);
+            conn.buffer.Clear();
+            handler.OnMessage(connID, s_msg);
+            if (conn.outSize == 0 || !conn.socket->GetConnected())
+            {
+                CloseConn(connID);
+                return false;
+            }
+            conn.closing = true; //     -       
+            UpdateOut(conn);
+            return true;
+        }
+    }
+
+    if (result != -3)
+    { // -1/-2 -     
+        CloseConn(connID);
+        return false;
+    }
+
+    return true;
+}
+
+/// <summary>
+///       
+/// </summary>
+/// <param name="connID"> - ID  </param>
+void network::TCP_reactor_t::Write(int connID)
+{
+    std::map<int, conn_t>::iterator iter = m_conn.find(connID);
+    if (iter == m_conn.end())
+        return;
+
+    conn_t& conn = iter->second;
+    if (!Flush(conn))
+    {
+        CloseConn(connID);
+        return;
+    }
+    UpdateOut(conn);
+
+    if (conn.closing)
+    {
+        if (conn.outSize == 0)
+            CloseConn(connID);
+    }
+    else if (conn.paused && conn.outSize <= lowWatermark)
+    { //   -  
+        if (manager.AddReader(AsSocket(conn.socket)))
+        {
+            conn.paused = false;
+            handler.OnDrain(connID);
+            Read(connID); //        ,      
+        }
+    }
+}
+
+/// <summary>
+///   ,    
+/// </summary>
+/// <param name="conn"> -  </param>
+/// <returns> 1 -  , 0 -   </returns>
+bool network::TCP_reactor_t::Flush(conn_t& conn)
+{
+    while (conn.outSize != 0)
+    {
+        if (conn.d_out.front().p_shared != nullptr)
+        { //   :        
+            outChunk_t& chunk = conn.d_out.front();
+            size_t size = chunk.p_shared->size() - conn.outOffset;
+            int result = conn.socket->SendZeroCopy(chunk.p_shared, conn.outOffset);
+            if (result == -3)
+                break;
+            if (result < 0)
+                return false;
+
+            if (result > 0)
+            {
+                conn.outSize -= result;
+                conn.outOffset += result;
+                break;
+            }
+            conn.outSize -= size;
+            conn.outOffset = 0;
+            conn.d_out.pop_front();
+            continue;
+        }
+
+        if (conn.d_out.front().count != 0)
+        { //      
+            outChunk_t& chunk = conn.d_out.front();
+            size_t count = chunk.count;
+            int result = conn.socket->SendFile(chunk.file, chunk.offset, chunk.count);
+            if (result == -3)
+                break; //    -  
+            if (result < 0)
+                return false;
+
+            if (result > 0)
+            { //    
+                conn.outSize -= count - chunk.count;
+                break;
+            }
+            conn.outSize -= count; //  ;    ,    
+            conn.d_out.pop_front();
+            continue;
+        }
+
+        //           
+        v_parts.clear();
+        size_t size = 0; //   
+        size_t offset = conn.outOffset;
+        for (std::deque<outChunk_t>::iterator iter = conn.d_out.begin(); iter != conn.d_out.end() && iter->count == 0 && iter->p_shared == nullptr && v_parts.size() < TCP_socketClient_t::PARTS_MAX; ++iter)
+        {
+            v_parts.push_back(slice_t(&iter->data[offset], iter->data.size() - offset));
+            size += iter->data.size() - offset;
+            offset = 0;
+        }
+
+        int result = conn.socket->Send(v_parts);
+        if (result == -3)
+            break; //    -  
+        if (result < 0)
+            return false;
+
+        size_t sent = (result == 0) ? size : size_t(result);
+        conn.outSize -= sent;
+        //   ,     
+        sent += conn.outOffset;
+        while (!conn.d_out.empty() && conn.d_out.front().count == 0 && conn.d_out.front().p_shared == nullptr && sent >= conn.d_out.front().data.size())
+        {
+            sent -= conn.d_out.front().data.size();
+            conn.d_out.pop_front();
+        }
+        conn.outOffset = sent;
+
+        if (result > 0)
+            break; //    
+    }
+
+    return true;
+}
+
+/// <summary>
+///        :    ,    ,
+///     
+/// </summary>
+/// <param name="conn"> -  </param>
+void network::TCP_reactor_t::UpdateOut(conn_t& conn)
+{
+    if (conn.outSize != 0 && !conn.writing)
+        conn.writing = manager.AddSender(AsSocket(conn.socket));
+    else if (conn.outSize == 0 && conn.writing)
+    {
+        manager.deleteSender(AsSocket(conn.socket));
+        conn.writing = false;
+    }
+
+    if (!conn.paused && (conn.closing || conn.outSize > highWatermark))
+    { //      -    
+        manager.deleteReader(AsSocket(conn.socket));
+        conn.paused = true;
+    }
+}
+
+/// <summary>
+///   
+/// </summary>
+/// <param name="connID"> - ID  </param>
+void network::TCP_reactor_t::CloseConn(int connID)
+{
+    std::map<int, conn_t>::iterator iter = m_conn.find(connID);
+    if (iter != m_conn.end())
+    {
+        std::shared_ptr<TCP_socketClient_t> socket = iter->second.socket;
+        manager.deleteReader(AsSocket(socket)); //      
+        if (socket->GetZeroCopyPending() != 0 && socket->ReapZeroCopy() >= 0 && socket->GetZeroCopyPending() != 0)
+        { //    :   ,       
+            if (iter->second.writing || manager.AddSender(AsSocket(socket)))
+                m_draining[connID] = socket;
+        }
+        else if (iter->second.writing)
+            manager.deleteSender(AsSocket(socket));
+        m_conn.erase(iter); //      
+        handler.OnClose(connID);
+    }
+}
+
+/// <summary>
+///     :  ,     
+/// </summary>
+/// <param name="iter"> -   m_draining </param>
+void network::TCP_reactor_t::Drain(std::map<int, std::shared_ptr<TCP_socketClient_t>>::iterator iter)
+{
+    if (iter->second->ReapZeroCopy() < 0 || iter->second->GetZeroCopyPending() == 0)
+    {
+        manager.deleteSender(AsSocket(iter->second));
+        m_draining.erase(iter);
+    }
+}
+
+/// <summary>
+/// 
+/// </summary>
+/// <param name="server"> -  ,       </param>
+/// <param name="handler"> -   </param>
+/// <param name="logger"> -   </param>
+/// <param name="str_EndOfMessege"> -   ;   -      ,
+///      (   --) </param>
+/// <param name="maxMsgSize"> -   ,       </param>
+network::TCP_reactor_t::TCP_reactor_t(std::shared_ptr<TCP_socketServer_t> server, ABSreactorHandler& handler, log_t& logger,
+    const std::string str_EndOfMessege, size_t maxMsgSize) :
+    TCP_reactor_t(server, handler, logger, str_EndOfMessege.empty() ? std::unique_ptr<ABScodec>() : std::unique_ptr<ABScodec>(new delimiterCodec_t(str_EndOfMessege, maxMsgSize)))
+{}
+
+/// <summary>
+///    
+/// </summary>
+/// <param name="server"> -  ,       </param>
+/// <param name="handler"> -   </param>
+/// <param name="logger"> -   </param>
+/// <param name="codec"> -  ,     ;  -   
+///     </param>
+network::TCP_reactor_t::TCP_reactor_t(std::shared_ptr<TCP_socketServer_t> server, ABSreactorHandler& handler, log_t& logger,
+    std::unique_ptr<ABScodec> codec) :
+    RAII_OSsock(logger), connPool(0, 64), manager(1024, logger, true), server(server), handler(handler), p_codec(std::move(codec)),
+    highWatermark(1 << 20), lowWatermark(1 << 18), b_zeroCopy(false), placement(placement_t::NONE), placementIndex(0), p_resolver(nullptr),
+    logger(logger)
+{
+    if (server != nullptr)
+    {
+        serverSocket = AsSocket(server);
+        if (!manager.AddServer(serverSocket)) // AddServer     
+            logger.doLog("TCP_reactor_t - server socket not added");
+    }
+}
+
+/// <summary>
+/// 
+/// </summary>
+network::TCP_reactor_t::~TCP_reactor_t()
+{
+    while (!m_conn.empty())
+        CloseConn(m_conn.begin()->first);
+    for (std::map<int, std::shared_ptr<TCP_socketClient_t>>::iterator iter = m_draining.begin(); iter != m_draining.end(); ++iter)
+        manager.deleteSender(AsSocket(iter->second));
+    m_draining.clear();
+    SetResolver(nullptr);
+    if (serverSocket != nullptr)
+        manager.deleteServer(serverSocket);
+}
+
+/// <summary>
+///   :     
+/// </summary>
+/// <param name="timeOut"> -      </param>
+/// <returns> 1 -      </returns>
+bool network::TCP_reactor_t::Work(const int timeOut)
+{
+    bool result = manager.Work(p_resolver != nullptr ? p_resolver->GetWait(timeOut) : timeOut);
+
+    if (result)
+    {
+        if (serverSocket != nullptr && manager.GetReadyServer(serverSocket))
+            Accept();
+        //        
+        const std::map<int, std::shared_ptr<socket_t>>& m_errors = manager.GetReadyErrors();
+        for (std::map<int, std::shared_ptr<socket_t>>::const_iterator iter = m_errors.begin(); iter != m_errors.end(); ++iter)
+        {
+            std::map<int, conn_t>::iterator conn = m_conn.find(iter->first);
+            if (conn != m_conn.end())
+                conn->second.socket->ReapZeroCopy();
+            else
+            {
+                std::map<int, std::shared_ptr<TCP_socketClient_t>>::iterator draining = m_draining.find(iter->first);
+                if (draining != m_draining.end())
+                    Drain(draining);
+            }
+        }
+        //  : Write/Read        
+        std::vector<int> v_ready;
+        const std::map<int, std::shared_ptr<socket_t>>& m_senders = manager.GetReadySenders();
+        v_ready.reserve(m_senders.size());
+        for (std::map<int, std::shared_ptr<socket_t>>::const_iterator iter = m_senders.begin(); iter != m_senders.end(); ++iter)
+            v_ready.push_back(iter->first);
+        //  :     
+        for (size_t index = 0; index < v_ready.size(); ++index)
+            Write(v_ready[index]);
+
+        v_ready.clear();
+        const std::map<int, std::shared_ptr<socket_t>>& m_ready = manager.GetReadyReaders();
+        for (std::map<int, std::shared_ptr<socket_t>>::const_iterator iter = m_ready.begin(); iter != m_ready.end(); ++iter)
+            v_ready.push_back(iter->first);
+
+        for (size_t index = 0; index < v_ready.size(); ++index)
+            Read(v_ready[index]); //   DNS    
+    }
+    if (p_resolver != nullptr) //  DNS    
+        p_resolver->Work(0);
+
+    return result;
+}
+
+/// <summary>
+///      
+/// </summary>
+/// <param name="stop"> -   </param>
+void network::TCP_reactor_t::Run(const volatile std::atomic_bool& stop)
+{
+    if (placement != placement_t::NONE) //    ,     , -   
+        PlaceThread(placement, placementIndex);
+    while (!stop)
+        Work(100); //      
+}
+
+/// <summary>
+///          NUMA:   Run()   
+/// </summary>
+/// <param name="policy"> -  placement_t </param>
+/// <param name="index"> -      (      NUMA) </param>
+void network::TCP_reactor_t::SetPlacement(int policy, unsigned index)
+{
+    placement = policy;
+    placementIndex = index;
+}
+
+/// <summary>
+///    DNS:       ,     
+///        Work(0) -  Resolve     .
+/// Resolve      ;   ,  
+/// </summary>
+/// <param name="resolver"> -  DNS, nullptr -  </param>
+void network::TCP_reactor_t::SetResolver(dnsResolver_t* resolver)
+{
+    if (p_resolver != nullptr)
+        manager.deleteReader(p_resolver->GetSocket());
+    p_resolver = resolver;
+    if (p_resolver != nullptr && !manager.AddReader(p_resolver->GetSocket()))
+        logger.doLog("TCP_reactor_t - resolver socket not added");
+}
+
+/// <summary>
+///     
+/// </summary>
+/// <returns>   </returns>
+size_t network::TCP_reactor_t::GetConnCount() const
+{
+    return m_conn.size();
+}
+
+/// <summary>
+///    :      ,     -
+///       
+/// </summary>
+/// <param name="connID"> - ID  </param>
+/// <param name="msg"> -  </param>
+/// <returns> 0 -    ;
+///           N>0 -    N ;
+///           -1 -  ,   ;
+///           -2 -   </returns>
+int network::TCP_reactor_t::Send(int connID, const std::string& msg)
+{
+    std::map<int, conn_t>::iterator iter = m_conn.find(connID);
+    if (iter == m_conn.end())
+        return -2;
+
+    conn_t& conn = iter->second;
+    const std::string* p_out = &msg; //  :      
+    if (conn.codec != nullptr)
+    {
+        s_frame.clear();
+        conn.codec->Encode(msg.data(), msg.size(), s_frame);
+        p_out = &s_frame;
+    }
+
+    size_t sent = 0;
+    if (conn.outSize == 0)
+    { //   -  ,      
+        int result = conn.socket->Send(*p_out);
+        if (result == 0)
+            sent = p_out->size();
+        else if (result > 0)
+            sent = result;
+        else if (result != -3)
+            return -1; //    
+    }
+
+    if (sent < p_out->size())
+    {
+        conn.d_out.push_back(outChunk_t());
+        conn.d_out.back().data.assign(*p_out, sent, std::string::npos);
+        conn.d_out.back().count = 0;
+        conn.outSize += p_out->size() - sent;
+        UpdateOut(conn);
+    }
+
+    return int(conn.outSize);
+}
+
+/// <summary>
+///          
+/// </summary>
+/// <param name="connID"> - ID  </param>
+/// <param name="file"> -   </param>
+/// <param name="offset"> -     </param>
+/// <param name="count"> -   </param>
+/// <returns> 0 -    ;
+///           N>0 -    N ;
+///           -1 -  ,   ;
+///           -2 -   </returns>
+int network::TCP_reactor_t::SendFile(int connID, FILE_HANDLE file, long long offset, size_t count)
+{
+    std::map<int, conn_t>::iterator iter = m_conn.find(connID);
+    if (iter == m_conn.end())
+        return -2;
+
+    conn_t& conn = iter->second;
+    if (conn.outSize == 0)
+    { //   -  
+        int result = conn.socket->SendFile(file, offset, count);
+        if (result == 0)
+            count = 0; //  ,    
+        else if (result < 0 && result != -3)
+            return -1; //    
+    }
+
+    if (count != 0)
+    {
+        conn.d_out.push_back(outChunk_t());
+        conn.d_out.back().file = file;
+        conn.d_out.back().offset = offset;
+        conn.d_out.back().count = count;
+        conn.outSize += count;
+        UpdateOut(conn);
+    }
+
+    return int(conn.outSize);
+}
+
+/// <summary>
+///     
+/// </summary>
+/// <param name="high"> -  :        </param>
+/// <param name="low"> -  :        </param>
+void network::TCP_reactor_t::SetWatermarks(size_t high, size_t low)
+{
+    highWatermark = high;
+    lowWatermark = low < high ? low : high;
+}
+
+/// <summary>
+///      
+/// </summary>
+/// <param name="connID"> - ID  </param>
+/// <returns>     </returns>
+size_t network::TCP_reactor_t::GetQueuedSize(int connID) const
+{
+    std::map<int, conn_t>::const_iterator iter = m_conn.find(connID);
+    return iter != m_conn.end() ? iter->second.outSize : 0;
+}
+
+/// <summary>
+///        
+/// </summary>
+/// <param name="connID"> - ID  </param>
+/// <param name="buffer"> - ,     </param>
+/// <returns> 0 -    ;
+///           N>0 -    N ;
+///           -1 -  ,   ;
+///           -2 -   </returns>
+int network::TCP_reactor_t::SendZeroCopy(int connID, const std::shared_ptr<const std::string>& buffer)
+{
+    std::map<int, conn_t>::iterator iter = m_conn.find(connID);
+    if (iter == m_conn.end() || buffer == nullptr)
+        return -2;
+
+    conn_t& conn = iter->second;
+    size_t sent = 0;
+    if (conn.outSize == 0)
+    { //   -  
+        int result = conn.socket->SendZeroCopy(buffer);
+        if (result == 0)
+            sent = buffer->size();
+        else if (result > 0)
+            sent = result;
+        else if (result != -3)
+            return -1; //    
+    }
+
+    if (sent < buffer->size())
+    { //      ,   ;     outOffset
+        if (conn.d_out.empty())
+            conn.outOffset = sent;
+        else
+            sent = 0; //    -     
+        conn.d_out.push_back(outChunk_t());
+        conn.d_out.back().p_shared = buffer;
+        conn.d_out.back().count = 0;
+        conn.outSize += buffer->size() - sent;
+        UpdateOut(conn);
+    }
+
+    return int(conn.outSize);
+}
+
+/// <summary>
+///      (SO_ZEROCOPY)      
+/// </summary>
+/// <param name="enable"> - 1 - ; 0 -  </param>
+void network::TCP_reactor_t::SetZeroCopy(bool enable)
+{
+    b_zeroCopy = enable;
+    for (std::map<int, conn_t>::iterator iter = m_conn.begin(); iter != m_conn.end(); ++iter)
+        iter->second.socket->SetZeroCopy(enable);
+}
@@ -0,0 +1,291 @@
+#pragma once
+#ifndef REACTOR_H_
+#define REACTOR_H_
+
+#include <atomic>
+#include <deque>
+
+#include "network.h"
+#include "codec.h"
+#include "slab.h"
+#include "topology.h"
+#include "dns.h"
+
+namespace network
+{
+    /// <summary>
+    ///      TCP_reactor_t.     ,
+    ///       (,   )
+    /// </summary>
+    class ABSreactorHandler
+    {
+    public:
+        /// <summary>
+        ///     
+        /// </summary>
+        /// <param name="connID"> - ID    </param>
+        /// <param name="msg"> -    ,    swap/move </param>
+        virtual void OnMessage(int connID, std::string& msg) = 0;
+
+        /// <summary>
+        ///    
+        /// </summary>
+        /// <param name="connID"> - ID    </param>
+        /// <param name="peer"> -    </param>
+        virtual void OnConnect(int /*connID*/, const sockInfo_t& /*peer*/) {}
+
+        /// <summary>
+        ///    
+        /// </summary>
+        /// <param name="connID"> - ID    </param>
+        virtual void OnClose(int /*connID*/) {}
+
+        /// <summary>
+        ///     :      ,   
+        /// </summary>
+        /// <param name="connID"> - ID    </param>
+        virtual void OnDrain(int /*connID*/) {}
+
+        virtual ~ABSreactorHandler() {}
+    };
+
+    /// <summary>
+    ///   TCP    :  ,       ,
+    ///     .   -   ,       .
+    ///           ;     ,
+    ///   ,       
+    /// </summary>
+    class TCP_reactor_t : private RAII_OSsock
+    {
+    protected:
+        /// <summary>
+        ///   : ,        
+        /// </summary>
+        struct outChunk_t
+        {
+            std::string data; //   (   )
+            std::shared_ptr<const std::string> p_shared; //     
+            FILE_HANDLE file; //  -  
+            long long offset; //    
+            size_t count; //   , 0 -  
+        };
+
+        /// <summary>
+        ///   
+        /// </summary>
+        struct conn_t
+        {
+            std::shared_ptr<TCP_socketClient_t> socket; //  
+            buffer_t buffer; // ,     
+            std::unique_ptr<ABScodec> codec; //    (  )
+            std::deque<outChunk_t> d_out; //  ,   
+            size_t outOffset; //       
+            size_t outSize; //   
+            bool writing; //      
+            bool paused; //   (    )
+            bool closing; //  ,    
+
+            conn_t() : outOffset(0), outSize(0), writing(false), paused(false), closing(false)
+            {}
+        };
+
+        /// <summary>
+        ///        
+        /// </summary>
+        void Accept();
+
+        /// <summary>
+        ///          
+        /// </summary>
+        /// <param name="connID"> - ID  </param>
+        /// <returns> 1 -  , 0 -    </returns>
+        bool Read(int connID);
+
+        /// <summary>
+        ///       
+        /// </summary>
+        /// <param name="connID"> - ID  </param>
+        void Write(int connID);
+
+        /// <summary>
+        ///   ,    
+        /// </summary>
+        /// <param name="conn"> -  </param>
+        /// <returns> 1 -  , 0 -   </returns>
+        bool Flush(conn_t& conn);
+
+        /// <summary>
+        ///        :    ,    ,
+        ///     
+        /// </summary>
+        /// <param name="conn"> -  </param>
+        void UpdateOut(conn_t& conn);
+
+        /// <summary>
+        ///   .        ,   
+        /// (    )  m_draining    -     
+        /// </summary>
+        /// <param name="connID"> - ID  </param>
+        void CloseConn(int connID);
+
+        /// <summary>
+        ///     :  ,     
+        /// </summary>
+        /// <param name="iter"> -   m_draining </param>
+        void Drain(std::map<int, std::shared_ptr<TCP_socketClient_t>>::iterator iter);
+
+        /// <summary>
+        ///         ( )
+        /// </summary>
+        static std::shared_ptr<socket_t> AsSocket(const std::shared_ptr<TCP_socketClient_t>& socket);
+
+        /// <summary>
+        ///         ( )
+        /// </summary>
+        static std::shared_ptr<socket_t> AsSocket(const std::shared_ptr<TCP_socketServer_t>& socket);
+
+    public:
+        /// <summary>
+        /// 
+        /// </summary>
+        /// <param name="server"> -  ,       </param>
+        /// <param name="handler"> -   </param>
+        /// <param name="logger"> -   </param>
+        /// <param name="str_EndOfMessege"> -   ;   -      ,
+        ///      (   --) </param>
+        /// <param name="maxMsgSize"> -   ,       </param>
+        TCP_reactor_t(std::shared_ptr<TCP_socketServer_t> server, ABSreactorHandler& handler, log_t& logger,
+            const std::string str_EndOfMessege = "", size_t maxMsgSize = 1 << 20);
+
+        /// <summary>
+        ///    
+        /// </summary>
+        /// <param name="server"> -  ,       </param>
+        /// <param name="handler"> -   </param>
+        /// <param name="logger"> -   </param>
+        /// <param name="codec"> -  ,     ;  -   
+        ///     </param>
+        TCP_reactor_t(std::shared_ptr<TCP_socketServer_t> server, ABSreactorHandler& handler, log_t& logger, std::unique_ptr<ABScodec> codec);
+
+        //  -   
+        TCP_reactor_t(const TCP_reactor_t& reactor) = delete;
+        TCP_reactor_t& operator = (const TCP_reactor_t& reactor) = delete;
+
+        virtual ~TCP_reactor_t();
+
+        /// <summary>
+        ///   :     
+        /// </summary>
+        /// <param name="timeOut"> -      </param>
+        /// <returns> 1 -      </returns>
+        bool Work(const int timeOut);
+
+        /// <summary>
+        ///      
+        /// </summary>
+        /// <param name="stop"> -   </param>
+        void Run(const volatile std::atomic_bool& stop);
+
+        /// <summary>
+        ///          NUMA:   Run()   
+        /// </summary>
+        /// <param name="policy"> -  placement_t </param>
+        /// <param name="index"> -      (      NUMA) </param>
+        void SetPlacement(int policy, unsigned index);
+
+        /// <summary>
+        ///    DNS:       ,     
+        ///        Work(0) -  Resolve     .
+        /// Resolve      ;   ,  
+        /// </summary>
+        /// <param name="resolver"> -  DNS, nullptr -  </param>
+        void SetResolver(dnsResolver_t* resolver);
+
+        /// <summary>
+        ///     
+        /// </summary>
+        /// <returns>   </returns>
+        size_t GetConnCount() const;
+
+        /// <summary>
+        ///    :      ,     -
+        ///       .     (,  )
+        /// </summary>
+        /// <param name="connID"> - ID  </param>
+        /// <param name="msg"> -  </param>
+        /// <returns> 0 -    ;
+        ///           N>0 -    N ;
+        ///           -1 -  ,   ;
+        ///           -2 -   </returns>
+        int Send(int connID, const std::string& msg);
+
+        /// <summary>
+        ///           (. TCP_socketClient_t::SendFile).
+        ///        ,     .   
+        /// ,      (GetQueuedSize)    
+        /// </summary>
+        /// <param name="connID"> - ID  </param>
+        /// <param name="file"> -   </param>
+        /// <param name="offset"> -     </param>
+        /// <param name="count"> -   </param>
+        /// <returns> 0 -    ;
+        ///           N>0 -    N ;
+        ///           -1 -  ,   ;
+        ///           -2 -   </returns>
+        int SendFile(int connID, FILE_HANDLE file, long long offset, size_t count);
+
+        /// <summary>
+        ///         (. TCP_socketClient_t::SendZeroCopy).  
+        ///  ,     ;     ,       
+        /// </summary>
+        /// <param name="connID"> - ID  </param>
+        /// <param name="buffer"> - ,     </param>
+        /// <returns> 0 -    ;
+        ///           N>0 -    N ;
+        ///           -1 -  ,   ;
+        ///           -2 -   </returns>
+        int SendZeroCopy(int connID, const std::shared_ptr<const std::string>& buffer);
+
+        /// <summary>
+        ///      (SO_ZEROCOPY)      
+        /// </summary>
+        /// <param name="enable"> - 1 - ; 0 -  </param>
+        void SetZeroCopy(bool enable);
+
+        /// <summary>
+        ///     
+        /// </summary>
+        /// <param name="high"> -  :        </param>
+        /// <param name="low"> -  :        </param>
+        void SetWatermarks(size_t high, size_t low);
+
+        /// <summary>
+        ///      
+        /// </summary>
+        /// <param name="connID"> - ID  </param>
+        /// <returns>     </returns>
+        size_t GetQueuedSize(int connID) const;
+
+    protected:
+        slabPool_t connPool; //       ,  ,   
+        NonBlockSocket_manager_t manager; //   
+        std::shared_ptr<TCP_socketServer_t> server; //  
+        std::shared_ptr<socket_t> serverSocket; //    ,  
+        std::map<int, conn_t> m_conn; //  ,  -   (  ID )
+        std::map<int, std::shared_ptr<TCP_socketClient_t>> m_draining; //  ,      
+        ABSreactorHandler& handler; //  
+        std::unique_ptr<ABScodec> p_codec; //    ( -     )
+        std::string s_msg; //     ,   
+        std::string s_frame; //     ,   
+        std::vector<slice_t> v_parts; //       
+        size_t highWatermark; //    
+        size_t lowWatermark; //    
+        bool b_zeroCopy; //    
+        int placement; //    
+        unsigned placementIndex; //      
+        dnsResolver_t* p_resolver; //  DNS,  
+        log_t& logger; //  
+    };
+};
+
+#endif /* REACTOR_H_ */
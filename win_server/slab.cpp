@@ -0,0 +1,85 @@
+#include "slab.h"
+
+/// <summary>
+/// 
+/// </summary>
+/// <param name="recordSize"> -  , 0 -    Allocate </param>
+/// <param name="blockRecords"> -        </param>
+slabPool_t::slabPool_t(size_t recordSize, size_t blockRecords) :
+    recordSize((recordSize + CACHE_LINE - 1) / CACHE_LINE * CACHE_LINE), BLOCK_RECORDS(blockRecords ? blockRecords : 1),
+    p_local(nullptr), p_returned(nullptr)
+{}
+
+/// <summary>
+///   .   -
+/// </summary>
+/// <param name="size"> -   </param>
+/// <returns>   nullptr,      </returns>
+void* slabPool_t::Allocate(size_t size)
+{
+    if (recordSize == 0) //    :  allocate_shared    
+        recordSize = (size + CACHE_LINE - 1) / CACHE_LINE * CACHE_LINE;
+    if (size > recordSize || size == 0)
+        return nullptr;
+
+    if (p_local == nullptr) //    -      
+        p_local = p_returned.exchange(nullptr, std::memory_order_acquire);
+    if (p_local == nullptr)
+        Grow();
+
+    free_t* result = p_local;
+    p_local = result->p_next;
+    return result;
+}
+
+/// <summary>
+///     .   
+/// </summary>
+/// <param name="p_record"> - ,   Allocate   </param>
+void slabPool_t::Free(void* p_record)
+{
+    if (p_record == nullptr)
+        return;
+
+    free_t* p_free = static_cast<free_t*>(p_record);
+    //    :     ,  ABA 
+    p_free->p_next = p_returned.load(std::memory_order_relaxed);
+    while (!p_returned.compare_exchange_weak(p_free->p_next, p_free, std::memory_order_release, std::memory_order_relaxed))
+    {}
+}
+
+/// <summary>
+///    
+/// </summary>
+/// <returns>   (0 -   ) </returns>
+size_t slabPool_t::RecordSize() const
+{
+    return recordSize;
+}
+
+/// <summary>
+///      
+/// </summary>
+/// <returns>     </returns>
+size_t slabPool_t::Capacity() const
+{
+    return v_block.size() * BLOCK_RECORDS;
+}
+
+/// <summary>
+///        
+/// </summary>
+void slabPool_t::Grow()
+{
+    //    -    
+    v_block.push_back(std::unique_ptr<char[]>(new char[recordSize * BLOCK_RECORDS + CACHE_LINE]));
+    size_t address = reinterpret_cast<size_t>(v_block.back().get());
+    char* p_begin = v_block.back().get() + (CACHE_LINE - address % CACHE_LINE) % CACHE_LINE;
+
+    for (size_t index = BLOCK_RECORDS; index-- > 0; )
+    {
+        free_t* p_free = reinterpret_cast<free_t*>(p_begin + index * recordSize);
+        p_free->p_next = p_local;
+        p_local = p_free;
+    }
+}
@@ -0,0 +1,143 @@
+#pragma once
+#ifndef SLAB_H_
+#define SLAB_H_
+
+#include <atomic>
+#include <memory>
+#include <vector>
+#include <cstddef>
+#include <new>
+
+/// <summary>
+///    ,   -.        
+///  ,      :    
+///       .
+///     (),     :      
+///      ,     
+/// </summary>
+class slabPool_t
+{
+protected:
+    /// <summary>
+    ///    (   )
+    /// </summary>
+    struct free_t
+    {
+        free_t* p_next; //   
+    };
+
+public:
+    static const size_t CACHE_LINE = 64; //     
+
+    /// <summary>
+    /// 
+    /// </summary>
+    /// <param name="recordSize"> -  , 0 -    Allocate </param>
+    /// <param name="blockRecords"> -        </param>
+    explicit slabPool_t(size_t recordSize = 0, size_t blockRecords = 256);
+
+    //  -     
+    slabPool_t(const slabPool_t& pool) = delete;
+    slabPool_t& operator = (const slabPool_t& pool) = delete;
+
+    /// <summary>
+    ///   .   -
+    /// </summary>
+    /// <param name="size"> -   </param>
+    /// <returns>   nullptr,      </returns>
+    void* Allocate(size_t size);
+
+    /// <summary>
+    ///     .   
+    /// </summary>
+    /// <param name="p_record"> - ,   Allocate   </param>
+    void Free(void* p_record);
+
+    /// <summary>
+    ///    
+    /// </summary>
+    /// <returns>   (0 -   ) </returns>
+    size_t RecordSize() const;
+
+    /// <summary>
+    ///      
+    /// </summary>
+    /// <returns>     </returns>
+    size_t Capacity() const;
+
+protected:
+    /// <summary>
+    ///        
+    /// </summary>
+    void Grow();
+
+    size_t recordSize; //  ,  CACHE_LINE
+    const size_t BLOCK_RECORDS; //   
+    std::vector<std::unique_ptr<char[]>> v_block; //  
+    free_t* p_local; //     
+    std::atomic<free_t*> p_returned; // ,   
+};
+
+/// <summary>
+///       slabPool_t.  std::allocate_shared    
+///     ,      .      
+/// </summary>
+/// <typeparam name="T"> -   </typeparam>
+template <typename T>
+class slabAllocator_t
+{
+    template <typename U> friend class slabAllocator_t;
+public:
+    typedef T value_type;
+
+    /// <summary>
+    /// 
+    /// </summary>
+    /// <param name="pool"> -  ,      </param>
+    explicit slabAllocator_t(slabPool_t& pool) : p_pool(&pool)
+    {}
+
+    /// <summary>
+    ///    (allocate_shared    )
+    /// </summary>
+    template <typename U>
+    slabAllocator_t(const slabAllocator_t<U>& allocator) : p_pool(allocator.p_pool)
+    {}
+
+    /// <summary>
+    ///     count 
+    /// </summary>
+    T* allocate(size_t count)
+    {
+        void* result = alignof(T) <= slabPool_t::CACHE_LINE ? p_pool->Allocate(count * sizeof(T)) : nullptr;
+        return static_cast<T*>(result != nullptr ? result : ::operator new(count * sizeof(T)));
+    }
+
+    /// <summary>
+    ///    count 
+    /// </summary>
+    void deallocate(T* p_data, size_t count)
+    {
+        if (alignof(T) <= slabPool_t::CACHE_LINE && count * sizeof(T) <= p_pool->RecordSize())
+            p_pool->Free(p_data);
+        else
+            ::operator delete(p_data);
+    }
+
+    template <typename U>
+    bool operator == (const slabAllocator_t<U>& rValue) const
+    {
+        return p_pool == rValue.p_pool;
+    }
+
+    template <typename U>
+    bool operator != (const slabAllocator_t<U>& rValue) const
+    {
+        return p_pool != rValue.p_pool;
+    }
+
+protected:
+    slabPool_t* p_pool; //  
+};
+
+#endif /* SLAB_H_ */
@@ -0,0 +1,329 @@
+#include "topology.h"
+
+#include <thread>
+#include <string>
+#include <fstream>
+#include <cstdlib>
+#include <algorithm>
+
+#ifdef __WIN32__
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif // !WIN32_LEAN_AND_MEAN
+#include <Windows.h>
+#else
+#include <pthread.h>
+#include <sched.h>
+#include <dirent.h>
+#include <unistd.h>
+#endif
+
+/// <summary>
+///       
+/// </summary>
+/// <param name="core"> -  ;       -      
+///   (   ) </param>
+/// <returns> 1 -   </returns>
+bool SetThreadAffinity(unsigned core)
+{
+    const cpuTopology_t& topology = cpuTopology_t::Get();
+    if (topology.NodeOfCore(core) < 0)
+    { //        (taskset, cpuset),      
+        size_t index = core % topology.CoreCount();
+        for (size_t node = 0; node < topology.NodeCount(); ++node)
+        {
+            const std::vector<unsigned>& v_cores = topology.NodeCores(node);
+            if (index < v_cores.size())
+            {
+                core = v_cores[index];
+                break;
+            }
+            index -= v_cores.size();
+        }
+    }
+#ifdef __WIN32__
+    return core < sizeof(DWORD_PTR) * 8 && 0 != SetThreadAffinityMask(GetCurrentThread(), DWORD_PTR(1) << core);
+#else
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(core, &set);
+    return 0 == pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+#endif
+}
+
+/// <summary>
+///       
+/// </summary>
+/// <param name="v_cores"> -   </param>
+/// <returns> 1 -   </returns>
+static bool SetThreadCores(const std::vector<unsigned>& v_cores)
+{
+#ifdef __WIN32__
+    DWORD_PTR mask = 0;
+    for (size_t index = 0; index < v_cores.size(); ++index)
+        if (v_cores[index] < sizeof(DWORD_PTR) * 8)
+            mask |= DWORD_PTR(1) << v_cores[index];
+    return mask != 0 && 0 != SetThreadAffinityMask(GetCurrentThread(), mask);
+#else
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (size_t index = 0; index < v_cores.size(); ++index)
+        if (v_cores[index] < CPU_SETSIZE)
+            CPU_SET(v_cores[index], &set);
+    return CPU_COUNT(&set) != 0 && 0 == pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+#endif
+}
+
+/// <summary>
+///         NUMA
+/// </summary>
+/// <param name="node"> -   (    ) </param>
+/// <returns> 1 -   </returns>
+bool SetThreadNode(unsigned node)
+{
+    return SetThreadCores(cpuTopology_t::Get().NodeCores(node));
+}
+
+/// <summary>
+///      
+/// </summary>
+/// <param name="policy"> -  placement_t </param>
+/// <param name="index"> -     </param>
+/// <returns>   , -1 -  NONE     </returns>
+int PlaceThread(int policy, unsigned index)
+{
+    const cpuTopology_t& topology = cpuTopology_t::Get();
+    int result = -1;
+
+    if (policy == placement_t::CORE)
+    {
+        unsigned core = topology.CoreOfIndex(index);
+        if (SetThreadAffinity(core))
+            result = topology.NodeOfCore(core);
+    }
+    else if (policy == placement_t::NODE)
+    {
+        if (SetThreadNode(unsigned(index % topology.NodeCount())))
+            result = int(index % topology.NodeCount());
+    }
+    else
+    { //    -       
+        std::vector<unsigned> v_all;
+        for (size_t node = 0; node < topology.NodeCount(); ++node)
+            v_all.insert(v_all.end(), topology.NodeCores(node).begin(), topology.NodeCores(node).end());
+        SetThreadCores(v_all);
+    }
+
+    return result;
+}
+
+/// <summary>
+///    
+/// </summary>
+/// <returns>    </returns>
+const cpuTopology_t& cpuTopology_t::Get()
+{
+    static const cpuTopology_t topology; //    
+    return topology;
+}
+
+/// <summary>
+/// :  
+/// </summary>
+cpuTopology_t::cpuTopology_t() : coreCount(0)
+{
+#ifdef __WIN32__
+    ULONG highest = 0;
+    if (GetNumaHighestNodeNumber(&highest))
+        for (ULONG node = 0; node <= highest; ++node)
+        {
+            ULONGLONG mask = 0;
+            if (GetNumaNodeProcessorMask(UCHAR(node), &mask) && mask != 0)
+            {
+                v_node.push_back(std::vector<unsigned>());
+                for (unsigned core = 0; core < 64; ++core)
+                    if (mask & (ULONGLONG(1) << core))
+                        v_node.back().push_back(core);
+            }
+        }
+#else
+    //    : /sys/devices/system/node/nodeN/cpulist   "0-3,8-11"
+    if (DIR* p_dir = opendir("/sys/devices/system/node"))
+    {
+        std::vector<unsigned> v_id;
+        while (dirent* p_entry = readdir(p_dir))
+        {
+            std::string name = p_entry->d_name;
+            if (name.size() > 4 && name.compare(0, 4, "node") == 0 && name.find_first_not_of("0123456789", 4) == std::string::npos)
+                v_id.push_back(unsigned(std::strtoul(name.c_str() + 4, nullptr, 10)));
+        }
+        closedir(p_dir);
+
+        std::vector<std::pair<unsigned, std::vector<unsigned>>> v_found;
+        for (size_t index = 0; index < v_id.size(); ++index)
+        {
+            std::ifstream file("/sys/devices/system/node/node" + std::to_string(v_id[index]) + "/cpulist");
+            std::string list;
+            std::vector<unsigned> v_cores;
+            if (std::getline(file, list))
+                for (const char* p_pos = list.c_str(); *p_pos != '\0'; )
+                {
+                    char* p_end = nullptr;
+                    unsigned first = unsigned(std::strtoul(p_pos, &p_end, 10));
+                    if (p_end == p_pos)
+                        break;
+                    unsigned last = first;
+                    if (*p_end == '-') //  
+                    {
+                        p_pos = p_end + 1;
+                        last = unsigned(std::strtoul(p_pos, &p_end, 10));
+                        if (p_end == p_pos)
+                            break;
+                    }
+                    for (unsigned core = first; core <= last; ++core)
+                        v_cores.push_back(core);
+                    if (*p_end != ',')
+                        break;
+                    p_pos = p_end + 1;
+                }
+            if (!v_cores.empty()) //    ( )   
+                v_found.push_back(std::make_pair(v_id[index], v_cores));
+        }
+        std::sort(v_found.begin(), v_found.end()); // readdir   ,      
+        for (size_t index = 0; index < v_found.size(); ++index)
+            v_node.push_back(v_found[index].second);
+    }
+#endif
+
+    // ,  ,    -   ,   
+    std::vector<unsigned> v_allowed;
+    if (AllowedCores(v_allowed))
+    {
+        std::vector<std::vector<unsigned>> v_all;
+        v_all.swap(v_node);
+        for (size_t node = 0; node < v_all.size(); ++node)
+        {
+            std::vector<unsigned> v_cores;
+            for (size_t index = 0; index < v_all[node].size(); ++index)
+                if (std::binary_search(v_allowed.begin(), v_allowed.end(), v_all[node][index]))
+                    v_cores.push_back(v_all[node][index]);
+            if (!v_cores.empty())
+                v_node.push_back(v_cores);
+        }
+    }
+
+    if (v_node.empty())
+    { //      -      
+        if (!v_allowed.empty())
+            v_node.push_back(v_allowed);
+        else
+        {
+            unsigned count = std::thread::hardware_concurrency();
+            v_node.push_back(std::vector<unsigned>());
+            for (unsigned core = 0; core < (count != 0 ? count : 1); ++core)
+                v_node.back().push_back(core);
+        }
+    }
+
+    for (size_t node = 0; node < v_node.size(); ++node)
+        for (size_t index = 0; index < v_node[node].size(); ++index)
+        {
+            unsigned core = v_node[node][index];
+            if (core >= v_coreNode.size())
+                v_coreNode.resize(core + 1, -1);
+            v_coreNode[core] = int(node);
+            ++coreCount;
+        }
+}
+
+/// <summary>
+///   ,     
+/// </summary>
+/// <param name="v_cores"> -      </param>
+/// <returns> 1 -   </returns>
+bool cpuTopology_t::AllowedCores(std::vector<unsigned>& v_cores)
+{
+    v_cores.clear();
+#ifdef __WIN32__
+    DWORD_PTR processMask = 0;
+    DWORD_PTR systemMask = 0;
+    if (!GetProcessAffinityMask(GetCurrentProcess(), &processMask, &systemMask))
+        return false;
+    for (unsigned core = 0; core < sizeof(DWORD_PTR) * 8; ++core)
+        if (processMask & (DWORD_PTR(1) << core))
+            v_cores.push_back(core);
+#else
+    //   :     ,     
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    if (sched_getaffinity(0, sizeof(set), &set) != 0)
+        return false;
+    for (unsigned core = 0; core < CPU_SETSIZE; ++core)
+        if (CPU_ISSET(core, &set))
+            v_cores.push_back(core);
+#endif
+    return !v_cores.empty();
+}
+
+/// <summary>
+///     NUMA
+/// </summary>
+/// <returns>   (  1) </returns>
+size_t cpuTopology_t::NodeCount() const
+{
+    return v_node.size();
+}
+
+/// <summary>
+///    
+/// </summary>
+/// <returns>     </returns>
+size_t cpuTopology_t::CoreCount() const
+{
+    return coreCount;
+}
+
+/// <summary>
+///    
+/// </summary>
+/// <param name="node"> -   (    ) </param>
+/// <returns>      </returns>
+const std::vector<unsigned>& cpuTopology_t::NodeCores(size_t node) const
+{
+    return v_node[node % v_node.size()];
+}
+
+/// <summary>
+///    
+/// </summary>
+/// <param name="core"> -   </param>
+/// <returns>  , -1 -   </returns>
+int cpuTopology_t::NodeOfCore(unsigned core) const
+{
+    return core < v_coreNode.size() ? v_coreNode[core] : -1;
+}
+
+/// <summary>
+///      :      ,   -  
+/// </summary>
+/// <param name="index"> -     </param>
+/// <returns>   </returns>
+unsigned cpuTopology_t::CoreOfIndex(unsigned index) const
+{
+    const std::vector<unsigned>& v_cores = v_node[index % v_node.size()];
+    return v_cores[(index / v_node.size()) % v_cores.size()];
+}
+
+/// <summary>
+///   ,       
+/// </summary>
+/// <returns>  , -1 -    </returns>
+int cpuTopology_t::CurrentNode()
+{
+#ifdef __WIN32__
+    return Get().NodeOfCore(GetCurrentProcessorNumber());
+#else
+    int core = sched_getcpu();
+    return core >= 0 ? Get().NodeOfCore(unsigned(core)) : -1;
+#endif
+}
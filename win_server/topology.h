@@ -0,0 +1,115 @@
+#pragma once
+#ifndef TOPOLOGY_H_
+#define TOPOLOGY_H_
+
+#include <vector>
+#include <cstddef>
+
+/// <summary>
+///       
+/// </summary>
+/// <param name="core"> -  ;       -      
+///   (   ) </param>
+/// <returns> 1 -   </returns>
+bool SetThreadAffinity(unsigned core);
+
+/// <summary>
+///         NUMA:      ,
+///        
+/// </summary>
+/// <param name="node"> -   (    ) </param>
+/// <returns> 1 -   </returns>
+bool SetThreadNode(unsigned node);
+
+/// <summary>
+///       
+/// </summary>
+struct placement_t
+{
+    static const int NONE = 0; //  ,      
+    static const int CORE = 1; //     ;       
+    static const int NODE = 2; //     NUMA (   );       
+};
+
+/// <summary>
+///      .   (  ,  ) 
+///  ,      :        ,  -  .
+/// ,         ( ,  slabPool_t,  ),
+///        
+/// </summary>
+/// <param name="policy"> -  placement_t </param>
+/// <param name="index"> -     </param>
+/// <returns>   , -1 -  NONE     </returns>
+int PlaceThread(int policy, unsigned index);
+
+/// <summary>
+///  :  NUMA   .          ,
+///   (taskset, cgroup cpuset);      ,      
+/// </summary>
+class cpuTopology_t
+{
+public:
+    /// <summary>
+    ///    
+    /// </summary>
+    /// <returns>    </returns>
+    static const cpuTopology_t& Get();
+
+    /// <summary>
+    ///     NUMA
+    /// </summary>
+    /// <returns>   (  1) </returns>
+    size_t NodeCount() const;
+
+    /// <summary>
+    ///    
+    /// </summary>
+    /// <returns>     </returns>
+    size_t CoreCount() const;
+
+    /// <summary>
+    ///    
+    /// </summary>
+    /// <param name="node"> -   (    ) </param>
+    /// <returns>      </returns>
+    const std::vector<unsigned>& NodeCores(size_t node) const;
+
+    /// <summary>
+    ///    
+    /// </summary>
+    /// <param name="core"> -   </param>
+    /// <returns>  , -1 -   </returns>
+    int NodeOfCore(unsigned core) const;
+
+    /// <summary>
+    ///      :      ,   -  
+    /// </summary>
+    /// <param name="index"> -     </param>
+    /// <returns>   </returns>
+    unsigned CoreOfIndex(unsigned index) const;
+
+    /// <summary>
+    ///   ,       
+    /// </summary>
+    /// <returns>  , -1 -    </returns>
+    static int CurrentNode();
+
+protected:
+    /// <summary>
+    /// :  
+    /// </summary>
+    cpuTopology_t();
+
+    /// <summary>
+    ///   ,     
+    /// </summary>
+    /// <param name="v_cores"> -      </param>
+    /// <returns> 1 -   </returns>
+    static bool AllowedCores(std::vector<unsigned>& v_cores);
+
+    std::vector<std::vector<unsigned>> v_node; //   
+    std::vector<int> v_coreNode; //    , -1 -  
+    size_t coreCount; //  
+};
+
+#endif /* TOPOLOGY_H_ */
@@ -0,0 +1,741 @@
+#include "uring.h"
+
+#ifdef URING_ENABLE
+
+#include <sys/mman.h>
+#include <sys/syscall.h>
+
+/// <summary>
+///       ,     
+/// </summary>
+/// <returns>    , nullptr -   </returns>
+io_uring_sqe* network::uringEngine_t::GetSqe()
+{
+    unsigned head = __atomic_load_n(sqHead, __ATOMIC_ACQUIRE);
+    unsigned tail = *sqTail;
+
+    if (tail - head >= params.sq_entries)
+    { //   -       
+        Submit();
+        head = __atomic_load_n(sqHead, __ATOMIC_ACQUIRE);
+        if (tail - head >= params.sq_entries)
+            return nullptr;
+    }
+
+    unsigned index = tail & *sqMask;
+    io_uring_sqe* sqe = &sqes[index];
+    memset(sqe, 0, sizeof(*sqe));
+    sqArray[index] = index;
+    //      io_uring_enter ( SQPOLL),       
+    __atomic_store_n(sqTail, tail + 1, __ATOMIC_RELEASE);
+    ++toSubmit;
+
+    return sqe;
+}
+
+/// <summary>
+///   
+/// </summary>
+/// <param name="socket"> -   (  nullptr) </param>
+/// <param name="fd"> -   </param>
+/// <param name="handler"> -  </param>
+/// <param name="server"> -    </param>
+/// <returns> ID , -1 -     </returns>
+int network::uringEngine_t::AddConn(std::shared_ptr<TCP_socketClient_t> socket, SOCKET fd, ABSuringHandler* handler, bool server)
+{
+    if (v_freeConn.empty())
+    {
+        logger.doLog("uringEngine_t - no free connection slot");
+        return -1;
+    }
+
+    int connID = v_freeConn.back();
+
+    if (fixedFiles)
+    { //        
+        io_uring_files_update update;
+        memset(&update, 0, sizeof(update));
+        update.offset = connID;
+        update.fds = (unsigned long long)&fd;
+        if (syscall(__NR_io_uring_register, ringFd, IORING_REGISTER_FILES_UPDATE, &update, 1) != 1)
+        {
+            logger.doLog("uringEngine_t - IORING_REGISTER_FILES_UPDATE fail ", GetError());
+            return -1;
+        }
+    }
+
+    v_freeConn.pop_back();
+    conn_t& conn = v_conn[connID];
+    conn.socket = socket;
+    conn.fd = fd;
+    conn.handler = handler;
+    conn.server = server;
+    conn.closing = false;
+    conn.waitRead = false;
+    conn.waitSend = false;
+    conn.readOp = -1;
+    conn.sendOp = -1;
+    conn.sendQueue.clear();
+    conn.sendOffset = 0;
+    conn.sendSize = 0;
+
+    return connID;
+}
+
+/// <summary>
+///        
+/// </summary>
+/// <param name="connID"> - ID  </param>
+void network::uringEngine_t::ReleaseConn(int connID)
+{
+    conn_t& conn = v_conn[connID];
+
+    if (fixedFiles)
+    { //     
+        int fd = -1;
+        io_uring_files_update update;
+        memset(&update, 0, sizeof(update));
+        update.offset = connID;
+        update.fds = (unsigned long long)&fd;
+        if (syscall(__NR_io_uring_register, ringFd, IORING_REGISTER_FILES_UPDATE, &update, 1) != 1)
+            logger.doLog("uringEngine_t - IORING_REGISTER_FILES_UPDATE fail ", GetError());
+    }
+
+    conn.socket = nullptr; //  ,   
+    conn.fd = INVALID_SOCKET;
+    conn.handler = nullptr;
+    conn.sendQueue.clear();
+    if (conn.waitRead) l_waitRead.remove(connID);
+    if (conn.waitSend) l_waitSend.remove(connID);
+    conn.waitRead = conn.waitSend = false;
+
+    v_freeConn.push_back(connID);
+}
+
+/// <summary>
+///   user_data :   + 1   32 ,    
+/// </summary>
+/// <param name="opIndex"> -   </param>
+/// <returns> user_data  </returns>
+unsigned long long network::uringEngine_t::UserData(int opIndex) const
+{
+    return ((unsigned long long)d_op[opIndex].gen << 32) | (unsigned)(opIndex + 1);
+}
+
+/// <summary>
+///     
+/// </summary>
+void network::uringEngine_t::PrepSqe(io_uring_sqe* sqe, int opcode, int connID, int opIndex)
+{
+    sqe->opcode = opcode;
+    if (fixedFiles)
+    { //   -    ,         
+        sqe->fd = connID;
+        sqe->flags |= IOSQE_FIXED_FILE;
+    }
+    else
+        sqe->fd = v_conn[connID].fd;
+    sqe->user_data = UserData(opIndex);
+}
+
+/// <summary>
+///      ( accept  ).      
+///    ,      
+/// </summary>
+/// <param name="connID"> - ID  </param>
+void network::uringEngine_t::ArmRead(int connID)
+{
+    conn_t& conn = v_conn[connID];
+    if (conn.closing || conn.readOp != -1 || conn.waitRead)
+        return;
+
+    io_uring_sqe* sqe = GetSqe();
+    if (sqe == nullptr)
+    { //   -     
+        conn.waitRead = true;
+        l_waitRead.push_back(connID);
+        return;
+    }
+
+    if (conn.server)
+    {
+        int opIndex = AllocOp(OP_ACCEPT, connID, -1);
+        op_t& op = d_op[opIndex];
+        op.addrLen = sizeof(op.addr);
+        PrepSqe(sqe, IORING_OP_ACCEPT, connID, opIndex);
+        sqe->addr = (unsigned long long)&op.addr;
+        sqe->addr2 = (unsigned long long)&op.addrLen;
+        sqe->accept_flags = SOCK_CLOEXEC;
+        conn.readOp = opIndex;
+    }
+    else
+    {
+        int opIndex = AllocOp(OP_READ, connID, -1);
+        PrepSqe(sqe, IORING_OP_RECV, connID, opIndex);
+        sqe->flags |= IOSQE_BUFFER_SELECT;
+        sqe->buf_group = RECV_GROUP;
+        sqe->len = bufSize;
+        conn.readOp = opIndex;
+    }
+}
+
+/// <summary>
+///        
+/// </summary>
+/// <param name="connID"> - ID  </param>
+void network::uringEngine_t::ArmWrite(int connID)
+{
+    conn_t& conn = v_conn[connID];
+    if (conn.closing || conn.sendOp != -1 || conn.waitSend || conn.sendQueue.empty())
+        return;
+
+    io_uring_sqe* sqe = v_freeBuf.empty() ? nullptr : GetSqe();
+    if (sqe == nullptr)
+    { //       -     
+        conn.waitSend = true;
+        l_waitSend.push_back(connID);
+        return;
+    }
+
+    int bufIndex = v_freeBuf.back();
+    v_freeBuf.pop_back();
+    int opIndex = AllocOp(OP_WRITE, connID, bufIndex);
+
+    //            -     
+    const std::string& front = conn.sendQueue.front();
+    size_t size = front.size() - conn.sendOffset;
+    if (size > bufSize) size = bufSize;
+    char* buffer = sendMemory + (size_t)bufIndex * bufSize;
+    memcpy(buffer, front.data() + conn.sendOffset, size);
+
+    PrepSqe(sqe, IORING_OP_WRITE_FIXED, connID, opIndex);
+    sqe->addr = (unsigned long long)buffer;
+    sqe->len = size;
+    sqe->buf_index = bufIndex;
+    conn.sendOp = opIndex;
+    conn.sendSize = size;
+}
+
+/// <summary>
+///      
+/// </summary>
+/// <param name="bufID"> -     </param>
+void network::uringEngine_t::ProvideBuffer(unsigned short bufID)
+{
+    io_uring_sqe* sqe = GetSqe();
+    if (sqe == nullptr)
+    {
+        logger.doLog("uringEngine_t - buffer lost, ring is full");
+        return;
+    }
+
+    sqe->opcode = IORING_OP_PROVIDE_BUFFERS;
+    sqe->fd = 1; //  
+    sqe->addr = (unsigned long long)(recvMemory + (size_t)bufID * bufSize);
+    sqe->len = bufSize;
+    sqe->off = bufID;
+    sqe->buf_group = RECV_GROUP;
+    sqe->user_data = PROVIDE_DATA;
+}
+
+/// <summary>
+///    ,        
+/// </summary>
+void network::uringEngine_t::RetryWaiting()
+{
+    size_t count = l_waitRead.size(); //     ,     
+    while (count-- > 0)
+    {
+        int connID = l_waitRead.front();
+        l_waitRead.pop_front();
+        v_conn[connID].waitRead = false;
+        ArmRead(connID);
+    }
+
+    count = l_waitSend.size();
+    while (count-- > 0)
+    {
+        int connID = l_waitSend.front();
+        l_waitSend.pop_front();
+        v_conn[connID].waitSend = false;
+        ArmWrite(connID);
+    }
+}
+
+/// <summary>
+///    
+/// </summary>
+/// <param name="userData"> - user_data  </param>
+/// <param name="res"> -   </param>
+/// <param name="flags"> -   (   ) </param>
+void network::uringEngine_t::Complete(unsigned long long userData, int res, unsigned flags)
+{
+    if (userData == TIMEOUT_DATA)
+    {
+        timeoutArmed = false;
+        return;
+    }
+    if (userData == PROVIDE_DATA)
+    {
+        if (res < 0)
+            logger.doLog("uringEngine_t - IORING_OP_PROVIDE_BUFFERS fail ", -res);
+        return;
+    }
+
+    int opIndex = (int)(userData & 0xFFFFFFFFULL) - 1;
+    if (opIndex < 0 || opIndex >= (int)d_op.size() || d_op[opIndex].gen != (unsigned)(userData >> 32))
+    { //      -   
+        logger.doLog("uringEngine_t - stale completion dropped");
+        return;
+    }
+    op_t& op = d_op[opIndex];
+    int connID = op.connID;
+    conn_t& conn = v_conn[connID];
+
+    switch (op.type)
+    {
+    case OP_ACCEPT:
+    {
+        conn.readOp = -1;
+        if (res >= 0)
+        { //       
+            std::shared_ptr<TCP_socketClient_t> client = std::make_shared<TCP_socketClient_t>(logger);
+            sockInfo_t clientInfo(logger);
+            memcpy(clientInfo.setSockAddr(), &op.addr, op.addrLen < sizeof(op.addr) ? op.addrLen : sizeof(op.addr));
+            clientInfo.UpdateSockInfo();
+
+            if (client->SetSocket(res, clientInfo) && !conn.closing)
+            {
+                int clientID = AddConn(client, res, conn.handler, false);
+                if (clientID >= 0)
+                {
+                    ArmRead(clientID);
+                    conn.handler->OnAccept(connID, clientID);
+                }
+            } //      client
+        }
+        else if (res != -ECANCELED)
+            logger.doLog("uringEngine_t - accept fail ", -res);
+
+        FreeOp(opIndex);
+        ArmRead(connID); //       accept
+        break;
+    }
+    case OP_READ:
+    {
+        conn.readOp = -1;
+        FreeOp(opIndex);
+        bool hasBuffer = (flags & IORING_CQE_F_BUFFER) != 0;
+        unsigned short bufID = flags >> IORING_CQE_BUFFER_SHIFT;
+
+        if (conn.closing) //      
+            res = -ECANCELED;
+
+        if (res > 0)
+        { //      ,      
+            conn.handler->OnRecive(connID, recvMemory + (size_t)bufID * bufSize, res);
+            ArmRead(connID);
+        }
+        else if (res == 0)
+            conn.handler->OnRecive(connID, nullptr, -2); //  
+        else if (res == -ENOBUFS || res == -EINTR || res == -EAGAIN || (res == -ECANCELED && !conn.closing))
+        { //     -    ;         
+            conn.waitRead = true;
+            l_waitRead.push_back(connID);
+        }
+        else if (res != -ECANCELED)
+            conn.handler->OnRecive(connID, nullptr, (res == -ECONNRESET || res == -EPIPE) ? -2 : -1);
+
+        if (hasBuffer)
+            ProvideBuffer(bufID);
+        break;
+    }
+    case OP_WRITE:
+    {
+        conn.sendOp = -1;
+        v_freeBuf.push_back(op.bufIndex);
+        FreeOp(opIndex);
+
+        if (conn.closing) //      
+            res = -ECANCELED;
+
+        if (res > 0)
+        {
+            conn.sendOffset += res; //    ,    
+            if (conn.sendOffset >= conn.sendQueue.front().size())
+            {
+                conn.sendQueue.pop_front();
+                conn.sendOffset = 0;
+            }
+            if (conn.sendQueue.empty())
+                conn.handler->OnSend(connID, 0);
+            else
+                ArmWrite(connID);
+        }
+        else if (res == -EINTR || res == -EAGAIN || (res == -ECANCELED && !conn.closing))
+            ArmWrite(connID);
+        else if (res != -ECANCELED)
+        {
+            conn.sendQueue.clear();
+            conn.sendOffset = 0;
+            conn.handler->OnSend(connID, (res == 0 || res == -ECONNRESET || res == -EPIPE) ? -2 : -1);
+        }
+        break;
+    }
+    default: // OP_CANCEL
+        FreeOp(opIndex);
+        break;
+    }
+
+    if (conn.closing && conn.readOp == -1 && conn.sendOp == -1 && conn.fd != INVALID_SOCKET)
+        ReleaseConn(connID); //      
+}
+
+/// <summary>
+///     
+/// </summary>
+/// <returns>   </returns>
+int network::uringEngine_t::AllocOp(char type, int connID, int bufIndex)
+{
+    int opIndex;
+    if (v_freeOp.empty())
+    {
+        opIndex = d_op.size();
+        d_op.push_back(op_t());
+        d_op.back().gen = 0;
+    }
+    else
+    {
+        opIndex = v_freeOp.back();
+        v_freeOp.pop_back();
+    }
+
+    d_op[opIndex].type = type;
+    d_op[opIndex].connID = connID;
+    d_op[opIndex].bufIndex = bufIndex;
+    d_op[opIndex].gen = (d_op[opIndex].gen + 1) & 0x7FFFFFFF; //    : user_data    
+
+    return opIndex;
+}
+
+/// <summary>
+///    
+/// </summary>
+void network::uringEngine_t::FreeOp(int opIndex)
+{
+    v_freeOp.push_back(opIndex);
+}
+
+/// <summary>
+/// 
+/// </summary>
+/// <param name="entries"> -    </param>
+/// <param name="maxConn"> -    (   ) </param>
+/// <param name="bufCount"> -          </param>
+/// <param name="bufSize"> -    </param>
+/// <param name="logger"> -    </param>
+network::uringEngine_t::uringEngine_t(unsigned entries, unsigned maxConn, unsigned bufCount, unsigned bufSize, log_t& logger) :
+    RAII_OSsock(logger), ringFd(-1), sqRing(MAP_FAILED), cqRing(MAP_FAILED), sqRingSize(0), cqRingSize(0), sqes(nullptr), sqesSize(0),
+    toSubmit(0), fixedFiles(false), timeoutArmed(false), recvMemory(nullptr), sendMemory(nullptr), bufCount(bufCount), bufSize(bufSize), logger(logger)
+{
+    memset(&params, 0, sizeof(params));
+    memset(&timeout, 0, sizeof(timeout));
+
+    ringFd = syscall(__NR_io_uring_setup, entries, &params);
+    if (ringFd < 0)
+    { //   io_uring    -     NonBlockSocket_manager_t
+        logger.doLog("uringEngine_t - io_uring_setup fail ", GetError());
+        ringFd = -1;
+        return;
+    }
+    //     
+    sqRingSize = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    cqRingSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+    if (params.features & IORING_FEAT_SINGLE_MMAP)
+        sqRingSize = cqRingSize = (sqRingSize > cqRingSize) ? sqRingSize : cqRingSize;
+
+    sqRing = mmap(nullptr, sqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ringFd, IORING_OFF_SQ_RING);
+    if (params.features & IORING_FEAT_SINGLE_MMAP)
+        cqRing = sqRing;
+    else
+        cqRing = mmap(nullptr, cqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ringFd, IORING_OFF_CQ_RING);
+    sqesSize = params.sq_entries * sizeof(io_uring_sqe);
+    void* sqesMap = mmap(nullptr, sqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ringFd, IORING_OFF_SQES);
+
+    if (sqRing == MAP_FAILED || cqRing == MAP_FAILED || sqesMap == MAP_FAILED)
+    {
+        logger.doLog("uringEngine_t - mmap fail ", GetError());
+        if (sqesMap != MAP_FAILED) munmap(sqesMap, sqesSize);
+        return;
+    }
+    sqes = (io_uring_sqe*)sqesMap;
+
+    char* sq = (char*)sqRing;
+    char* cq = (char*)cqRing;
+    sqHead = (unsigned*)(sq + params.sq_off.head);
+    sqTail = (unsigned*)(sq + params.sq_off.tail);
+    sqMask = (unsigned*)(sq + params.sq_off.ring_mask);
+    sqArray = (unsigned*)(sq + params.sq_off.array);
+    cqHead = (unsigned*)(cq + params.cq_off.head);
+    cqTail = (unsigned*)(cq + params.cq_off.tail);
+    cqMask = (unsigned*)(cq + params.cq_off.ring_mask);
+    cqes = (io_uring_cqe*)(cq + params.cq_off.cqes);
+
+    //      -     ,     
+    if (posix_memalign((void**)&sendMemory, 4096, (size_t)bufCount * bufSize) || posix_memalign((void**)&recvMemory, 4096, (size_t)bufCount * bufSize))
+    {
+        logger.doLog("uringEngine_t - buffers allocation fail");
+        sqes = nullptr;
+        return;
+    }
+    std::vector<iovec> v_iov(bufCount);
+    v_freeBuf.reserve(bufCount);
+    for (unsigned index = 0; index < bufCount; ++index)
+    {
+        v_iov[index].iov_base = sendMemory + (size_t)index * bufSize;
+        v_iov[index].iov_len = bufSize;
+        v_freeBuf.push_back(bufCount - 1 - index);
+    }
+    if (syscall(__NR_io_uring_register, ringFd, IORING_REGISTER_BUFFERS, &v_iov[0], bufCount))
+    {
+        logger.doLog("uringEngine_t - IORING_REGISTER_BUFFERS fail ", GetError());
+        sqes = nullptr;
+        return;
+    }
+    //  ,   -1;       
+    std::vector<int> v_fd(maxConn, -1);
+    fixedFiles = maxConn > 0 && syscall(__NR_io_uring_register, ringFd, IORING_REGISTER_FILES, &v_fd[0], maxConn) == 0;
+    if (!fixedFiles)
+    {
+        DEBUG_TRACE(logger, "uringEngine_t - IORING_REGISTER_FILES not available");
+    }
+
+    v_conn.resize(maxConn);
+    v_freeConn.reserve(maxConn);
+    for (unsigned index = 0; index < maxConn; ++index)
+    {
+        v_conn[index].fd = INVALID_SOCKET;
+        v_conn[index].handler = nullptr;
+        v_freeConn.push_back(maxConn - 1 - index);
+    }
+
+    //       
+    io_uring_sqe* sqe = GetSqe();
+    sqe->opcode = IORING_OP_PROVIDE_BUFFERS;
+    sqe->fd = bufCount;
+    sqe->addr = (unsigned long long)recvMemory;
+    sqe->len = bufSize;
+    sqe->off = 0;
+    sqe->buf_group = RECV_GROUP;
+    sqe->user_data = PROVIDE_DATA;
+    Submit();
+}
+
+/// <summary>
+/// 
+/// </summary>
+network::uringEngine_t::~uringEngine_t()
+{
+    for (size_t index = 0; index < v_conn.size(); ++index)
+        v_conn[index].socket = nullptr; //    
+
+    if (sqes != nullptr) munmap(sqes, sqesSize);
+    if (cqRing != MAP_FAILED && cqRing != sqRing) munmap(cqRing, cqRingSize);
+    if (sqRing != MAP_FAILED) munmap(sqRing, sqRingSize);
+    if (ringFd != -1) close(ringFd); //     
+    free(recvMemory);
+    free(sendMemory);
+}
+
+/// <summary>
+///     (    io_uring)
+/// </summary>
+/// <returns> 1 -     </returns>
+bool network::uringEngine_t::Valid() const
+{
+    return ringFd != -1 && sqes != nullptr;
+}
+
+/// <summary>
+///    ,          accept.
+///          
+/// </summary>
+/// <param name="server"> -   </param>
+/// <param name="handler"> -       </param>
+/// <returns> ID , -1 -  </returns>
+int network::uringEngine_t::AddServer(TCP_socketServer_t& server, ABSuringHandler& handler)
+{
+    int result = -1;
+
+    if (Valid() && server.CheckValidSocket())
+        if ((result = AddConn(nullptr, server.getSocket(), &handler, true)) >= 0)
+            ArmRead(result);
+
+    return result;
+}
+
+/// <summary>
+///    ,    ,   
+/// </summary>
+/// <param name="client"> -  ,       </param>
+/// <param name="handler"> -   </param>
+/// <returns> ID , -1 -  </returns>
+int network::uringEngine_t::AddClient(TCP_socketClient_t& client, ABSuringHandler& handler)
+{
+    int result = -1;
+
+    if (Valid() && client.GetConnected())
+    {
+        std::shared_ptr<TCP_socketClient_t> socket = std::make_shared<TCP_socketClient_t>(logger);
+        socket->Move(client);
+        if ((result = AddConn(socket, socket->getSocket(), &handler, false)) >= 0)
+            ArmRead(result);
+        else
+            client.Move(*socket); //   
+    }
+
+    return result;
+}
+
+/// <summary>
+///       .     ,
+///       Submit()/Work()
+/// </summary>
+/// <param name="connID"> - ID  </param>
+/// <param name="data"> -  </param>
+/// <returns> 1 -     </returns>
+bool network::uringEngine_t::Send(int connID, const std::string& data)
+{
+    bool result = false;
+
+    if (connID >= 0 && connID < (int)v_conn.size() && v_conn[connID].fd != INVALID_SOCKET && !v_conn[connID].closing && !v_conn[connID].server)
+    {
+        if (!data.empty())
+        {
+            v_conn[connID].sendQueue.push_back(data);
+            ArmWrite(connID);
+        }
+        result = true;
+    }
+
+    return result;
+}
+
+/// <summary>
+///    (  ):    ,    
+/// </summary>
+/// <param name="connID"> - ID  </param>
+/// <returns> 1 -   </returns>
+bool network::uringEngine_t::Close(int connID)
+{
+    bool result = false;
+
+    if (connID >= 0 && connID < (int)v_conn.size() && v_conn[connID].fd != INVALID_SOCKET && !v_conn[connID].closing)
+    {
+        conn_t& conn = v_conn[connID];
+        conn.closing = true;
+        result = true;
+
+        int ops[2] = { conn.readOp, conn.sendOp };
+        for (int index = 0; index < 2; ++index)
+            if (ops[index] != -1)
+            { //    ,  ,     
+                io_uring_sqe* sqe = GetSqe();
+                if (sqe != nullptr)
+                {
+                    int opIndex = AllocOp(OP_CANCEL, connID, -1);
+                    sqe->opcode = IORING_OP_ASYNC_CANCEL;
+                    sqe->fd = -1;
+                    sqe->addr = UserData(ops[index]); //  : ,    ,   
+                    sqe->user_data = UserData(opIndex);
+                }
+            }
+
+        if (conn.readOp == -1 && conn.sendOp == -1)
+            ReleaseConn(connID);
+    }
+
+    return result;
+}
+
+/// <summary>
+///        
+/// </summary>
+/// <returns>   , -1 -   </returns>
+int network::uringEngine_t::Submit()
+{
+    int result = 0;
+
+    if (toSubmit > 0)
+    {
+        result = syscall(__NR_io_uring_enter, ringFd, toSubmit, 0, 0, nullptr, 0);
+        if (result >= 0)
+            toSubmit -= result;
+        else if (GetError() == EINTR || GetError() == EAGAIN || GetError() == EBUSY)
+            result = 0; //  ,    
+        else
+            logger.doLog("uringEngine_t - io_uring_enter fail ", GetError());
+    }
+
+    return result;
+}
+
+/// <summary>
+///    :         ,
+///      
+/// </summary>
+/// <param name="timeOut"> -     (-1 - ) </param>
+/// <returns>   , -1 -   </returns>
+int network::uringEngine_t::Work(const int timeOut)
+{
+    if (!Valid())
+        return -1;
+
+    if (timeOut > 0 && !timeoutArmed)
+    { //  -  :        
+        io_uring_sqe* sqe = GetSqe();
+        if (sqe != nullptr)
+        {
+            timeout.tv_sec = timeOut / 1000;
+            timeout.tv_nsec = (timeOut % 1000) * 1000000LL;
+            sqe->opcode = IORING_OP_TIMEOUT;
+            sqe->fd = -1;
+            sqe->addr = (unsigned long long)&timeout;
+            sqe->len = 1;
+            sqe->off = 1;
+            sqe->user_data = TIMEOUT_DATA;
+            timeoutArmed = true;
+        }
+    }
+    //    -       
+    unsigned waitFor = (timeOut != 0 && __atomic_load_n(cqTail, __ATOMIC_ACQUIRE) == *cqHead) ? 1 : 0;
+    int resEnter = syscall(__NR_io_uring_enter, ringFd, toSubmit, waitFor, waitFor ? IORING_ENTER_GETEVENTS : 0, nullptr, 0);
+    if (resEnter >= 0)
+        toSubmit -= resEnter;
+    else if (GetError() != EINTR && GetError() != EAGAIN && GetError() != EBUSY && GetError() != ETIME)
+    {
+        logger.doLog("uringEngine_t - io_uring_enter fail ", GetError());
+        return -1;
+    }
+
+    int result = 0;
+    unsigned head = *cqHead;
+    while (head != __atomic_load_n(cqTail, __ATOMIC_ACQUIRE))
+    {
+        io_uring_cqe* cqe = &cqes[head & *cqMask];
+        unsigned long long userData = cqe->user_data;
+        int res = cqe->res;
+        unsigned flags = cqe->flags;
+        __atomic_store_n(cqHead, ++head, __ATOMIC_RELEASE); //     
+
+        Complete(userData, res, flags);
+        if (userData != TIMEOUT_DATA && userData != PROVIDE_DATA)
+            ++result;
+    }
+
+    RetryWaiting();
+
+    return result;
+}
+
+#endif // URING_ENABLE
@@ -0,0 +1,299 @@
+#pragma once
+#ifndef URING_H_
+#define URING_H_
+
+#include "network.h"
+
+//     Linux        io_uring
+#if !defined(__WIN32__) && defined(__has_include)
+#if __has_include(<linux/io_uring.h>)
+#define URING_ENABLE
+#endif
+#endif
+
+#ifdef URING_ENABLE
+
+#include <deque>
+#include <linux/io_uring.h>
+#include <sys/uio.h>
+
+namespace network
+{
+    /// <summary>
+    ///      io_uring.
+    ///      ,    connID
+    /// </summary>
+    class ABSuringHandler
+    {
+    public:
+        /// <summary>
+        ///    ,  .     ,
+        ///    ,   ,      
+        /// </summary>
+        /// <param name="serverID"> - ID     </param>
+        /// <param name="connID"> - ID     </param>
+        virtual void OnAccept(int /*serverID*/, int /*connID*/) {}
+
+        /// <summary>
+        ///    
+        /// </summary>
+        /// <param name="connID"> - ID    </param>
+        /// <param name="data"> -   (    ) </param>
+        /// <param name="size"> - N>0 -  N ;
+        ///                       -1 -  ;
+        ///                       -2 -   </param>
+        virtual void OnRecive(int connID, const char* data, int size) = 0;
+
+        /// <summary>
+        ///    
+        /// </summary>
+        /// <param name="connID"> - ID    </param>
+        /// <param name="size"> - 0 -    ;
+        ///                       -1 -  ;
+        ///                       -2 -   </param>
+        virtual void OnSend(int /*connID*/, int /*size*/) {}
+
+        virtual ~ABSuringHandler() {}
+    };
+
+    /// <summary>
+    ///  -   io_uring.    ,      
+    ///         Work(),    .
+    ///      (WRITE_FIXED),  -  ,    
+    ///   (IOSQE_BUFFER_SELECT),      (IOSQE_FIXED_FILE).
+    ///   -    
+    /// </summary>
+    class uringEngine_t : private RAII_OSsock
+    {
+    protected:
+        /// <summary>
+        ///   ,   
+        /// </summary>
+        struct op_t
+        {
+            char type; //   OP_*
+            int connID; // ,    
+            int bufIndex; //     (-1 -  )
+            unsigned gen; //  ,     -    ,   
+            sockaddr_storage addr; //    accept,      
+            socklen_t addrLen; //     accept
+        };
+
+        /// <summary>
+        ///  ,   
+        /// </summary>
+        struct conn_t
+        {
+            std::shared_ptr<TCP_socketClient_t> socket; //   (nullptr    )
+            SOCKET fd; //  
+            ABSuringHandler* handler; //  
+            bool server; //   -    accept
+            bool closing; //  ,   
+            bool waitRead; //      ,   l_waitRead
+            bool waitSend; //      ,   l_waitSend
+            int readOp; //   /accept   (-1 - )
+            int sendOp; //      (-1 - )
+            std::list<std::string> sendQueue; // ,  
+            size_t sendOffset; //       
+            size_t sendSize; //  ,   
+        };
+
+        static const char OP_ACCEPT = 1; //    
+        static const char OP_READ = 2; //   
+        static const char OP_WRITE = 3; //   
+        static const char OP_CANCEL = 4; //   
+        static const unsigned long long TIMEOUT_DATA = ~0ULL; // user_data  
+        static const unsigned long long PROVIDE_DATA = ~0ULL - 1; // user_data    
+        static const unsigned short RECV_GROUP = 0; //   
+
+        /// <summary>
+        ///       ,     
+        /// </summary>
+        /// <returns>    , nullptr -   </returns>
+        io_uring_sqe* GetSqe();
+
+        /// <summary>
+        ///   
+        /// </summary>
+        /// <param name="socket"> -   (  nullptr) </param>
+        /// <param name="fd"> -   </param>
+        /// <param name="handler"> -  </param>
+        /// <param name="server"> -    </param>
+        /// <returns> ID , -1 -     </returns>
+        int AddConn(std::shared_ptr<TCP_socketClient_t> socket, SOCKET fd, ABSuringHandler* handler, bool server);
+
+        /// <summary>
+        ///        
+        /// </summary>
+        /// <param name="connID"> - ID  </param>
+        void ReleaseConn(int connID);
+
+        /// <summary>
+        ///      ( accept  ).      
+        ///    ,      
+        /// </summary>
+        /// <param name="connID"> - ID  </param>
+        void ArmRead(int connID);
+
+        /// <summary>
+        ///        
+        /// </summary>
+        /// <param name="connID"> - ID  </param>
+        void ArmWrite(int connID);
+
+        /// <summary>
+        ///      
+        /// </summary>
+        /// <param name="bufID"> -     </param>
+        void ProvideBuffer(unsigned short bufID);
+
+        /// <summary>
+        ///    ,        
+        /// </summary>
+        void RetryWaiting();
+
+        /// <summary>
+        ///   user_data :   + 1   32 ,    
+        /// </summary>
+        /// <param name="opIndex"> -   </param>
+        /// <returns> user_data  </returns>
+        unsigned long long UserData(int opIndex) const;
+
+        /// <summary>
+        ///     
+        /// </summary>
+        void PrepSqe(io_uring_sqe* sqe, int opcode, int connID, int opIndex);
+
+        /// <summary>
+        ///    
+        /// </summary>
+        /// <param name="userData"> - user_data  </param>
+        /// <param name="res"> -   </param>
+        /// <param name="flags"> -   (   ) </param>
+        void Complete(unsigned long long userData, int res, unsigned flags);
+
+        /// <summary>
+        ///     
+        /// </summary>
+        /// <returns>   </returns>
+        int AllocOp(char type, int connID, int bufIndex);
+
+        /// <summary>
+        ///    
+        /// </summary>
+        void FreeOp(int opIndex);
+
+    public:
+        /// <summary>
+        /// 
+        /// </summary>
+        /// <param name="entries"> -    </param>
+        /// <param name="maxConn"> -    (   ) </param>
+        /// <param name="bufCount"> -          </param>
+        /// <param name="bufSize"> -    </param>
+        /// <param name="logger"> -    </param>
+        uringEngine_t(unsigned entries, unsigned maxConn, unsigned bufCount, unsigned bufSize, log_t& logger);
+
+        //  -     
+        uringEngine_t(const uringEngine_t& engine) = delete;
+        uringEngine_t& operator = (const uringEngine_t& engine) = delete;
+
+        virtual ~uringEngine_t();
+
+        /// <summary>
+        ///     (    io_uring)
+        /// </summary>
+        /// <returns> 1 -     </returns>
+        bool Valid() const;
+
+        /// <summary>
+        ///    ,          accept.
+        ///          
+        /// </summary>
+        /// <param name="server"> -   </param>
+        /// <param name="handler"> -       </param>
+        /// <returns> ID , -1 -  </returns>
+        int AddServer(TCP_socketServer_t& server, ABSuringHandler& handler);
+
+        /// <summary>
+        ///    ,    ,   
+        /// </summary>
+        /// <param name="client"> -  ,       </param>
+        /// <param name="handler"> -   </param>
+        /// <returns> ID , -1 -  </returns>
+        int AddClient(TCP_socketClient_t& client, ABSuringHandler& handler);
+
+        /// <summary>
+        ///       .     ,
+        ///       Submit()/Work()
+        /// </summary>
+        /// <param name="connID"> - ID  </param>
+        /// <param name="data"> -  </param>
+        /// <returns> 1 -     </returns>
+        bool Send(int connID, const std::string& data);
+
+        /// <summary>
+        ///    (  ):    ,    
+        /// </summary>
+        /// <param name="connID"> - ID  </param>
+        /// <returns> 1 -   </returns>
+        bool Close(int connID);
+
+        /// <summary>
+        ///        
+        /// </summary>
+        /// <returns>   , -1 -   </returns>
+        int Submit();
+
+        /// <summary>
+        ///    :         ,
+        ///      
+        /// </summary>
+        /// <param name="timeOut"> -     (-1 - ) </param>
+        /// <returns>   , -1 -   </returns>
+        int Work(const int timeOut);
+
+    protected:
+        int ringFd; //  io_uring
+        io_uring_params params; //  ,  
+        void* sqRing; //   
+        void* cqRing; //   
+        size_t sqRingSize; //    
+        size_t cqRingSize; //    
+        io_uring_sqe* sqes; //  
+        size_t sqesSize; //    
+        unsigned* sqHead; //    ( )
+        unsigned* sqTail; //    ( )
+        unsigned* sqMask; //    
+        unsigned* sqArray; //   
+        unsigned* cqHead; //    ( )
+        unsigned* cqTail; //    ( )
+        unsigned* cqMask; //    
+        io_uring_cqe* cqes; //  
+        unsigned toSubmit; // ,   ,      
+
+        bool fixedFiles; //    
+        bool timeoutArmed; //     
+        __kernel_timespec timeout; //     
+
+        char* recvMemory; //    ( RECV_GROUP)
+        char* sendMemory; //    
+        unsigned bufCount; //    
+        unsigned bufSize; //  
+        std::vector<int> v_freeBuf; //   
+        std::list<int> l_waitRead; // ,        
+        std::list<int> l_waitSend; // ,        
+
+        std::deque<op_t> d_op; //  , deque -   ,    op_t::addr
+        std::vector<int> v_freeOp; //  
+
+        std::vector<conn_t> v_conn; // ,  - ID     
+        std::vector<int> v_freeConn; //  ID 
+
+        log_t& logger; //  
+    };
+};
+
+#endif // URING_ENABLE
+
+#endif /* URING_H_ */
@@ -1,12 +1,18 @@
 ﻿// win_server.cpp : Этот файл содержит функцию "main". Здесь начинается и заканчивается выполнение программы.
 //
 #include "network.h"
+#include "reactor.h"
+#include "uring.h"
 #include "poolThread.h"
+#include "slab.h"
 
 #include <list>
 #include <string>
 #include <mutex>
 #include <memory>
+#include <thread>
+#include <vector>
+#include <cstring>
 
 #define IP_ADRES "127.0.0.1"
 
@@ -46,34 +52,240 @@ public:
 	}
 };
 
+/// <summary>
+/// класс реализация задачи записи одного уже принятого сообщения
+/// </summary>
+class taskLogMsg_t : public ABStask
+{
+private:
+	log_t& r_logger; // ссылка на логгер для записи сообщения в файл
+	std::mutex& r_mutex; // ссылка на мьютекс для блокирования записи в файл
+	std::string s_msg; // принятое сообщение
+public:
+	/// <summary>
+	/// конструктор, для создания задачи
+	/// </summary>
+	/// <param name="logger"> - ссылка на логгер - ресурс для параллельного доступа к записи в файл </param>
+	/// <param name="mutex"> - ссылка на мьютекс - защита от одновременного доступа к записи в файл </param>
+	/// <param name="msg"> - сообщение, после вызова пустое (забираем без копирования) </param>
+	taskLogMsg_t(log_t& logger, std::mutex& mutex, std::string& msg) : r_logger(logger), r_mutex(mutex)
+	{
+		s_msg.swap(msg);
+	}
+
+	/// <summary>
+	/// основной метод работы задачи
+	/// </summary>
+	/// <param name="stop"> - флаг останова цикла, передается от пула потоков (здесь не используется, т.к. нет цикла) </param>
+	void Work(const volatile std::atomic_bool& /*stop*/) override
+	{
+		if (r_logger.IsAsync())
+			r_logger.doLog(s_msg); // асинхронный логгер сам разводит потоки по своим буферам
+		else
+		{
+			std::lock_guard<std::mutex> lock(r_mutex);
+			r_logger.doLog(s_msg); // записываем его с защитой от одновременно доступа
+		}
+	}
+};
+
+/// <summary>
+/// класс обработчик цикла событий: готовые сообщения отправляет в пул потоков
+/// </summary>
+class reactorHandler_t : public network::ABSreactorHandler
+{
+private:
+	log_t& r_logger; // ссылка на логгер для записи сообщений в файл
+	std::mutex& r_mutex; // ссылка на мьютекс для блокирования записи в файл
+	poolThread_manager_t& r_pool; // пул потоков для обработки сообщений
+	slabPool_t& r_slab; // записи задач, выделяет только поток своего цикла
+public:
+	/// <summary>
+	/// конструктор
+	/// </summary>
+	/// <param name="logger"> - ссылка на логгер </param>
+	/// <param name="mutex"> - ссылка на мьютекс записи в файл </param>
+	/// <param name="pool"> - ссылка на пул потоков </param>
+	/// <param name="slab"> - ссылка на пул записей задач, должен пережить пул потоков </param>
+	reactorHandler_t(log_t& logger, std::mutex& mutex, poolThread_manager_t& pool, slabPool_t& slab) : r_logger(logger), r_mutex(mutex), r_pool(pool),
+		r_slab(slab)
+	{}
+
+	/// <summary>
+	/// метод обработки принятого сообщения, вызывается в потоке цикла событий - только ставит задачу
+	/// </summary>
+	/// <param name="connID"> - ID соединения </param>
+	/// <param name="msg"> - сообщение </param>
+	void OnMessage(int /*connID*/, std::string& msg) override
+	{ // задача и ее счетчики ссылок лежат в одной записи пула, освобождает ее рабочий поток пула
+		r_pool.AddTask(std::allocate_shared<taskLogMsg_t>(slabAllocator_t<taskLogMsg_t>(r_slab), r_logger, r_mutex, msg));
+	}
+};
+
+#ifdef URING_ENABLE
+/// <summary>
+/// класс обработчик движка io_uring: первая принятая порция данных соединения - сообщение, оно уходит в пул потоков,
+/// соединение закрывается (как в цикле событий без признака конца сообщения)
+/// </summary>
+class uringHandler_t : public network::ABSuringHandler
+{
+private:
+	log_t& r_logger; // ссылка на логгер для записи сообщений в файл
+	std::mutex& r_mutex; // ссылка на мьютекс для блокирования записи в файл
+	poolThread_manager_t& r_pool; // пул потоков для обработки сообщений
+	network::uringEngine_t& r_engine; // движок, соединения которого обслуживает обработчик
+public:
+	/// <summary>
+	/// конструктор
+	/// </summary>
+	/// <param name="logger"> - ссылка на логгер </param>
+	/// <param name="mutex"> - ссылка на мьютекс записи в файл </param>
+	/// <param name="pool"> - ссылка на пул потоков </param>
+	/// <param name="engine"> - ссылка на движок </param>
+	uringHandler_t(log_t& logger, std::mutex& mutex, poolThread_manager_t& pool, network::uringEngine_t& engine) :
+		r_logger(logger), r_mutex(mutex), r_pool(pool), r_engine(engine)
+	{}
+
+	/// <summary>
+	/// метод обработки завершения чтения, вызывается в потоке движка - только ставит задачу
+	/// </summary>
+	/// <param name="connID"> - ID соединения в движке </param>
+	/// <param name="data"> - принятые данные </param>
+	/// <param name="size"> - размер данных, меньше 0 - ошибка или соединение закрыто </param>
+	void OnRecive(int connID, const char* data, int size) override
+	{
+		if (size > 0)
+		{
+			std::string msg(data, size); // буфер движка действителен только на время вызова
+			r_pool.AddTask(std::make_shared<taskLogMsg_t>(r_logger, r_mutex, msg));
+		}
+		r_engine.Close(connID);
+	}
+};
+
+/// <summary>
+/// функция работы сервера на движке io_uring: u32_loops потоков, у каждого свой движок
+/// </summary>
+/// <param name="port"> - порт для прослушки </param>
+/// <param name="loops"> - количество потоков движка </param>
+/// <param name="logger"> - ссылка на логгер </param>
+/// <param name="mutex"> - ссылка на мьютекс записи в файл </param>
+/// <param name="pool"> - ссылка на пул потоков </param>
+/// <returns> 0 - ядро не поддерживает io_uring, нужно работать на цикле событий </returns>
+bool runUring(unsigned port, unsigned loops, log_t& logger, std::mutex& mutex, poolThread_manager_t& pool)
+{
+	std::vector<std::unique_ptr<network::uringEngine_t>> v_engine;
+	std::vector<std::unique_ptr<uringHandler_t>> v_handler;
+	for (unsigned index = 0; index < loops; ++index)
+	{
+		v_engine.push_back(std::unique_ptr<network::uringEngine_t>(new network::uringEngine_t(256, 1024, 256, 4096, logger)));
+		if (!v_engine.back()->Valid())
+			return false;
+		v_handler.push_back(std::unique_ptr<uringHandler_t>(new uringHandler_t(logger, mutex, pool, *v_engine.back())));
+	}
+	// заявки на accept всех движков висят на одном слушающем сокете, ядро отдает соединение одной из них
+	network::TCP_socketServer_t h_server(IP_ADRES, port, logger);
+	for (unsigned index = 0; index < loops; ++index)
+		if (v_engine[index]->AddServer(h_server, *v_handler[index]) < 0)
+			return false;
+
+	std::vector<std::thread> v_thread;
+	for (unsigned index = 1; index < loops; ++index) // первый движок работает в главном потоке
+		v_thread.push_back(std::thread([&v_engine, index]() { while (v_engine[index]->Work(100) >= 0) {} }));
+
+	while (v_engine[0]->Work(100) >= 0) {}
+
+	for (size_t index = 0; index < v_thread.size(); ++index)
+		v_thread[index].join();
+	return true;
+}
+#endif // URING_ENABLE
+
 /// <summary>
 /// функция разобра параметров командной строки
 /// </summary>
 /// <param name="argc"> - количество параметров </param>
 /// <param name="argv"> - массив параметров </param>
 /// <param name="r_port"> - ссылка на порт для прослушки </param>
+/// <param name="r_loops"> - ссылка на количество потоков цикла событий (0 - поток пула на каждое соединение) </param>
+/// <param name="r_uring"> - ссылка на признак работы на движке io_uring вместо цикла событий </param>
 /// <returns> 1 - праметры распознаны </returns>
-bool parseParam(int argc, char* argv[], unsigned& r_port);
+bool parseParam(int argc, char* argv[], unsigned& r_port, unsigned& r_loops, bool& r_uring);
 
 
 int main(int argc, char* argv[])
 {
 	printf("run_server\n");
 	unsigned u32_port = 0;
+	unsigned u32_loops = 1;
+	bool b_uring = false;
 
-	if (parseParam(argc, argv, u32_port))
+	if (parseParam(argc, argv, u32_port, u32_loops, b_uring))
 	{
-		log_t h_logger("log.txt", false); // объект для записи принятых сообщений в файл
-		network::TCP_socketServer_t h_server(IP_ADRES, u32_port, h_logger); // сокет для работы сервера
+		log_t h_logger("log.txt", false, log_t::policy_t::BLOCK); // объект для записи принятых сообщений в файл, пишет отдельный поток
 		std::mutex h_mutex;
-		poolThread_manager_t h_pool(3); // пул потоков для обработки клиентских соединений
-		network::TCP_socketClient_t h_tempSock(h_logger); // промежуточный сокет для создания соединения с клиентом
+		slabPool_t h_slab; // записи соединений переиспользуются, должен пережить пул потоков
+		std::vector<std::unique_ptr<slabPool_t>> v_slab; // записи задач циклов событий, по пулу на цикл; должны пережить пул потоков
+		// пул потоков для обработки клиентских соединений: 3 потока всегда, при ожидании задач в очереди дольше 2 мс
+		// пул растет до 16 потоков, лишние потоки завершаются после минуты простоя
+		poolThread_manager_t h_pool(3, 16, std::chrono::milliseconds(2), std::chrono::seconds(60));
 
-		while (0 == h_server.AddClient(h_tempSock)) // если получилось получить нового клиента
-			h_pool.AddTask(std::make_shared<taskOutPutMsg_t>(h_logger, h_mutex, h_tempSock)); // формируем задачу для обработки этого соединения
+		if (u32_loops == 0)
+		{ // режим задача-на-соединение: поток пула занят клиентом, пока тот не пришлет сообщение
+			network::TCP_socketServer_t h_server(IP_ADRES, u32_port, h_logger); // сокет для работы сервера
+			network::TCP_socketClient_t h_tempSock(h_logger); // промежуточный сокет для создания соединения с клиентом
+
+			while (0 == h_server.AddClient(h_tempSock)) // если получилось получить нового клиента
+				// формируем задачу для обработки этого соединения: задача и ее счетчики ссылок лежат в одной записи пула
+				h_pool.AddTask(std::allocate_shared<taskOutPutMsg_t>(slabAllocator_t<taskOutPutMsg_t>(h_slab), h_logger, h_mutex, h_tempSock));
+		}
+#ifdef URING_ENABLE
+		else if (b_uring && runUring(u32_port, u32_loops, h_logger, h_mutex, h_pool))
+		{} // движок отработал; без поддержки io_uring в ядре сервер работает на цикле событий
+#endif // URING_ENABLE
+		else
+		{ // режим цикла событий: прием и чтение всех клиентов в u32_loops потоках, в пул уходят только готовые сообщения
+			// если ОС умеет распределять соединения - у каждого цикла свой слушающий сокет и своя очередь на подключение,
+			// иначе все циклы делят один сокет
+			bool b_shard = u32_loops > 1 && network::TCP_socketServer_t::ReusePortSupported();
+			std::shared_ptr<network::TCP_socketServer_t> h_server;
+			std::vector<std::unique_ptr<reactorHandler_t>> v_handler; // у каждого цикла свой обработчик: записи задач выделяет его поток
+			std::atomic_bool b_stop(false);
+			std::vector<std::shared_ptr<network::TCP_reactor_t>> v_reactor;
+			std::vector<std::thread> v_thread;
+
+			for (unsigned index = 0; index < u32_loops; ++index)
+			{
+				if (b_shard)
+				{
+					std::shared_ptr<network::TCP_socketServer_t> h_shard = std::make_shared<network::TCP_socketServer_t>(IP_ADRES, u32_port, true, h_logger);
+					if (h_shard->GetListening())
+						h_server = h_shard;
+					else // свой сокет не получился - этот и следующие циклы делят последний слушающий сокет
+						b_shard = false;
+				}
+				if (h_server == nullptr)
+					h_server = std::make_shared<network::TCP_socketServer_t>(IP_ADRES, u32_port, h_logger);
+				v_slab.push_back(std::unique_ptr<slabPool_t>(new slabPool_t()));
+				v_handler.push_back(std::unique_ptr<reactorHandler_t>(new reactorHandler_t(h_logger, h_mutex, h_pool, *v_slab.back())));
+				v_reactor.push_back(std::make_shared<network::TCP_reactor_t>(h_server, *v_handler.back(), h_logger));
+				// каждый цикл привязан к своему ядру, соседние циклы - на разных узлах NUMA:
+				// принятое соединение живет на ядре, которое его приняло, и в памяти его узла
+				v_reactor.back()->SetPlacement(placement_t::CORE, index);
+			}
+			// рабочие потоки пула размещаются по узлам: сообщение соединения обрабатывает поток того же узла, что и цикл
+			h_pool.SetPlacement(placement_t::NODE);
+			for (unsigned index = 1; index < u32_loops; ++index) // первый цикл работает в главном потоке
+				v_thread.push_back(std::thread([&v_reactor, &b_stop, index]() { v_reactor[index]->Run(b_stop); }));
+
+			v_reactor[0]->Run(b_stop);
+
+			for (size_t index = 0; index < v_thread.size(); ++index)
+				v_thread[index].join();
+		}
 	}
 	else
-		printf("Invalid parametr's. Please enter the number_port\n");
+		printf("Invalid parametr's. Please enter the number_port [number_loops, 0 - thread per connection] [uring]\n");
 
 	return EXIT_SUCCESS;
 }
@@ -84,15 +296,27 @@ int main(int argc, char* argv[])
 /// <param name="argc"> - количество параметров </param>
 /// <param name="argv"> - массив параметров </param>
 /// <param name="r_port"> - ссылка на порт для прослушки </param>
+/// <param name="r_loops"> - ссылка на количество потоков цикла событий (0 - поток пула на каждое соединение) </param>
+/// <param name="r_uring"> - ссылка на признак работы на движке io_uring вместо цикла событий </param>
 /// <returns> 1 - праметры распознаны </returns>
-bool parseParam(int argc, char* argv[], unsigned& r_port)
+bool parseParam(int argc, char* argv[], unsigned& r_port, unsigned& r_loops, bool& r_uring)
 {
 	bool b_result = false;
 
-	if (argc == 2)
+	if (argc >= 2 && argc <= 4)
 	{
 		r_port = std::strtoul(argv[1], NULL, 10);
 		b_result = r_port != 0 && r_port != ULONG_MAX;
+		if (argc >= 3)
+		{
+			r_loops = std::strtoul(argv[2], NULL, 10);
+			b_result = b_result && r_loops != ULONG_MAX;
+		}
+		if (argc == 4)
+		{ // движок работает только в режиме циклов
+			r_uring = std::strcmp(argv[3], "uring") == 0;
+			b_result = b_result && r_uring && r_loops != 0;
+		}
 	}
 
 	return b_result;
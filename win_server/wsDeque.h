@@ -0,0 +1,129 @@
+#pragma once
+#ifndef WSDEQUE_H_
+#define WSDEQUE_H_
+
+#include <atomic>
+#include <memory>
+#include <cstddef>
+
+/// <summary>
+///  -       .
+///         CAS (  ),  
+///      CAS.  ,     
+/// </summary>
+/// <typeparam name="T"> -  ,    T* </typeparam>
+template <typename T>
+class wsDeque_t
+{
+public:
+    /// <summary>
+    /// 
+    /// </summary>
+    /// <param name="capacity"> -  ,      </param>
+    explicit wsDeque_t(size_t capacity) : MASK(RoundUp(capacity) - 1), p_cells(new std::atomic<T*>[MASK + 1]), top(0), bottom(0)
+    {
+        for (size_t index = 0; index <= MASK; ++index)
+            p_cells[index].store(nullptr, std::memory_order_relaxed);
+    }
+
+    //  -    
+    wsDeque_t(const wsDeque_t& deque) = delete;
+    wsDeque_t& operator = (const wsDeque_t& deque) = delete;
+
+    /// <summary>
+    ///     .   
+    /// </summary>
+    /// <param name="value"> -  </param>
+    /// <returns> 1 -  ; 0 -   </returns>
+    bool Push(T* value)
+    {
+        long long b = bottom.load(std::memory_order_relaxed);
+        long long t = top.load(std::memory_order_acquire);
+        if (b - t > (long long)MASK)
+            return false;
+
+        // release  : ,  ,      
+        p_cells[b & MASK].store(value, std::memory_order_release);
+        std::atomic_thread_fence(std::memory_order_release); //     
+        bottom.store(b + 1, std::memory_order_relaxed);
+        return true;
+    }
+
+    /// <summary>
+    ///      ( ).   
+    /// </summary>
+    /// <returns>   nullptr,    </returns>
+    T* Pop()
+    {
+        long long b = bottom.load(std::memory_order_relaxed) - 1;
+        bottom.store(b, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst); //     
+        long long t = top.load(std::memory_order_relaxed);
+
+        T* result = nullptr;
+        if (t <= b)
+        {
+            result = p_cells[b & MASK].load(std::memory_order_relaxed);
+            if (t == b)
+            { //   -     
+                if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+                    result = nullptr;
+                bottom.store(b + 1, std::memory_order_relaxed);
+            }
+        }
+        else //    -  
+            bottom.store(b + 1, std::memory_order_relaxed);
+
+        return result;
+    }
+
+    /// <summary>
+    ///      ( ).   
+    /// </summary>
+    /// <returns>   nullptr,         </returns>
+    T* Steal()
+    {
+        long long t = top.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        long long b = bottom.load(std::memory_order_acquire);
+
+        T* result = nullptr;
+        if (t < b)
+        {
+            result = p_cells[t & MASK].load(std::memory_order_acquire);
+            if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+                result = nullptr; //     
+        }
+
+        return result;
+    }
+
+    /// <summary>
+    ///     ( ,   )
+    /// </summary>
+    /// <returns> 1 -      </returns>
+    bool Empty() const
+    {
+        return bottom.load(std::memory_order_seq_cst) <= top.load(std::memory_order_seq_cst);
+    }
+
+protected:
+    /// <summary>
+    ///      
+    /// </summary>
+    static size_t RoundUp(size_t capacity)
+    {
+        size_t result = 2;
+        while (result < capacity)
+            result <<= 1;
+        return result;
+    }
+
+    const size_t MASK; //    ( - 1)
+    std::unique_ptr<std::atomic<T*>[]> p_cells; //  
+    std::atomic<long long> top; //  -    
+    char pad[64 - sizeof(std::atomic<long long>)]; //      -
+    std::atomic<long long> bottom; //  -   
+};
+
+#endif /* WSDEQUE_H_ */